@@ -18,6 +18,28 @@ export function listToJsArray(csArr) {
     return arr;
 }
 
+// 和TDataTrans.h里的SignatureHash一致(FNV-1a 64)，签名只包含ascii字符
+export function signatureHash(signature) {
+    let hash = 0xcbf29ce484222325n;
+    for (let i = 0; i < signature.length; ++i) {
+        hash ^= BigInt(signature.charCodeAt(i));
+        hash = (hash * 0x100000001b3n) & 0xffffffffffffffffn;
+    }
+    return hash;
+}
+
+export function signatureHashLiteral(signature) {
+    return `0x${signatureHash(signature).toString(16)}ULL`;
+}
+
+// 生成的签名表按hash升序排列，运行时按hash二分查找，签名字符串只用于排除hash冲突
+export function sortBySignatureHash(infos) {
+    return infos
+        .map(info => ({ info, hash: signatureHash(info.Signature) }))
+        .sort((x, y) => x.hash < y.hash ? -1 : (x.hash > y.hash ? 1 : 0))
+        .map(x => x.info);
+}
+
 export const PrimitiveSignatureCppTypeMap = {
     v: 'void',
     b: 'bool',
@@ -115,10 +115,10 @@ namespace puerts
 ${bridgeInfos.map(genBridge).join('\n')}
 
 static BridgeFuncInfo g_bridgeFuncInfos[] = {
-    ${FOR(bridgeInfos, info => t`
-    {"${info.Signature}", (Il2CppMethodPointer)b_${info.Signature}},
+    ${FOR(il2cpp_snippets.sortBySignatureHash(bridgeInfos), info => t`
+    {${il2cpp_snippets.signatureHashLiteral(info.Signature)}, "${info.Signature}", (Il2CppMethodPointer)b_${info.Signature}},
     `)}
-    {nullptr, nullptr}
+    {0, nullptr, nullptr}
 };
 
 
@@ -126,11 +126,8 @@ Il2CppMethodPointer FindBridgeFunc(const char* signature)
 {
     auto begin = &g_bridgeFuncInfos[0];
     auto end = &g_bridgeFuncInfos[sizeof(g_bridgeFuncInfos) / sizeof(BridgeFuncInfo) - 1];
-    auto first = std::lower_bound(begin, end, signature, [](const BridgeFuncInfo& x, const char* signature) {return strcmp(x.Signature, signature) < 0;});
-    if (first != end && strcmp(first->Signature, signature) == 0) {
-        return first->Method;
-    }
-    return nullptr;
+    auto info = FindBySignatureHash(begin, end, signature);
+    return info ? info->Method : nullptr;
 }
 
 }
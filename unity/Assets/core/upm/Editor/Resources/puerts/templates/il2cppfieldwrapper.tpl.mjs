@@ -89,21 +89,17 @@ namespace puerts
 ${fieldWrapperInfos.map(genFieldWrapper).join('\n')}
 
 static FieldWrapFuncInfo g_fieldWrapFuncInfos[] = {
-    ${FOR(fieldWrapperInfos, info => t`
-    {"${info.Signature}", ifg_${info.Signature}, ifs_${info.Signature}},
+    ${FOR(il2cpp_snippets.sortBySignatureHash(fieldWrapperInfos), info => t`
+    {${il2cpp_snippets.signatureHashLiteral(info.Signature)}, "${info.Signature}", ifg_${info.Signature}, ifs_${info.Signature}},
     `)}
-    {nullptr, nullptr, nullptr}    
+    {0, nullptr, nullptr, nullptr}    
 };
 
 FieldWrapFuncInfo * FindFieldWrapFuncInfo(const char* signature)
 {
     auto begin = &g_fieldWrapFuncInfos[0];
     auto end = &g_fieldWrapFuncInfos[sizeof(g_fieldWrapFuncInfos) / sizeof(FieldWrapFuncInfo) - 1];
-    auto first = std::lower_bound(begin, end, signature, [](const FieldWrapFuncInfo& x, const char* signature) {return strcmp(x.Signature, signature) < 0;});
-    if (first != end && strcmp(first->Signature, signature) == 0) {
-        return first;
-    }
-    return nullptr;
+    return FindBySignatureHash(begin, end, signature);
 }
 
 }
@@ -27,21 +27,18 @@ namespace puerts
 ${wrapperInfos.map((wrapperInfo) => `bool w_${wrapperInfo.Signature}(struct pesapi_ffi* apis, MethodInfo* method, Il2CppMethodPointer methodPointer, pesapi_callback_info info, pesapi_env env, void* self, bool checkJSArgument, WrapData* wrapData);`).join('\n')}
 
 static WrapFuncInfo g_wrapFuncInfos[] = {
-    ${FOR(wrapperInfos, info => t`
-    {"${info.Signature}", w_${info.Signature}},
+    ${FOR(il2cpp_snippets.sortBySignatureHash(wrapperInfos), info => t`
+    {${il2cpp_snippets.signatureHashLiteral(info.Signature)}, "${info.Signature}", w_${info.Signature}},
     `)}
-    {nullptr, nullptr}
+    {0, nullptr, nullptr}
 };
 
 WrapFuncPtr FindWrapFunc(const char* signature)
 {
     auto begin = &g_wrapFuncInfos[0];
     auto end = &g_wrapFuncInfos[sizeof(g_wrapFuncInfos) / sizeof(WrapFuncInfo) - 1];
-    auto first = std::lower_bound(begin, end, signature, [](const WrapFuncInfo& x, const char* signature) {return strcmp(x.Signature, signature) < 0;});
-    if (first != end && strcmp(first->Signature, signature) == 0) {
-        return first->Method;
-    }
-    return nullptr;
+    auto info = FindBySignatureHash(begin, end, signature);
+    return info ? info->Method : nullptr;
 }
 
 }
@@ -39,6 +39,11 @@ namespace Puerts
 #endif
     public delegate void V8DestructorCallback(IntPtr self, long data);
 
+#if UNITY_EDITOR_WIN || UNITY_STANDALONE_WIN || PUERTS_GENERAL || (UNITY_WSA && !UNITY_EDITOR)
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+#endif
+    public delegate void ExternalArrayBufferRelease(IntPtr data, long userData);
+
 #if UNITY_EDITOR_WIN || UNITY_STANDALONE_WIN || PUERTS_GENERAL || (UNITY_WSA && !UNITY_EDITOR)
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
 #endif
@@ -63,6 +68,27 @@ namespace Puerts
         Any = NullOrUndefined | BigInt | Number | String | Boolean | NativeObject | JsObject | Array | Function | Date | ArrayBuffer,
     };
 
+    // 与native的puerts::FBatchValue布局一致
+    // String/ArrayBuffer: offset为在data区的字节偏移，length为字节长度；NativeObject: ptr为对象指针(这里传的是对象池id)，length为classId
+    [StructLayout(LayoutKind.Explicit, Size = 16)]
+    public struct BatchValue
+    {
+        [FieldOffset(0)]
+        public JsValueType type;
+        [FieldOffset(4)]
+        public int length;
+        [FieldOffset(8)]
+        public double number;
+        [FieldOffset(8)]
+        public long bigInt;
+        [FieldOffset(8)]
+        public long boolean;
+        [FieldOffset(8)]
+        public long offset;
+        [FieldOffset(8)]
+        public IntPtr ptr;
+    }
+
     public class PuertsDLL
     {
 #if (UNITY_IPHONE || UNITY_TVOS || UNITY_WEBGL || UNITY_SWITCH) && !UNITY_EDITOR
@@ -104,6 +130,43 @@ namespace Puerts
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr CreateJSEngineWithExternalEnv(int backendType, IntPtr externalRuntime, IntPtr externalContext);
 
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr CreateJSEngineWithSnapshot(int backendType, byte[] snapshot, int length);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr CreateJSEngineWithPooledAllocator(int backendType);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr CreateSnapshot(byte[] bootstrapScript, string path, out int length);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr GetSnapshotErrorInfo(out int strlen);
+
+        // 只有v8后端支持，失败返回null，错误信息通过GetSnapshotErrorInfo获取
+        public static byte[] CreateSnapshotChecked(string bootstrapScript, string path)
+        {
+            if (bootstrapScript == null)
+            {
+                throw new InvalidProgramException("create snapshot for null string");
+            }
+            int length;
+            IntPtr ptr = CreateSnapshot(Encoding.UTF8.GetBytes(bootstrapScript + '\0'), path, out length);
+            if (ptr == IntPtr.Zero)
+            {
+                return null;
+            }
+            byte[] snapshot = new byte[length];
+            Marshal.Copy(ptr, snapshot, 0, length);
+            return snapshot;
+        }
+
+        public static string GetSnapshotErrorInfo()
+        {
+            int strlen;
+            IntPtr str = GetSnapshotErrorInfo(out strlen);
+            return GetStringFromNative(str, strlen);
+        }
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern void DestroyJSEngine(IntPtr isolate);
 
@@ -137,6 +200,26 @@ namespace Puerts
         }
 
 
+        // str指向native侧的UTF-16缓冲，直接构造string，只分配一次
+        private static string GetUtf16StringFromNative(IntPtr str, int strlen)
+        {
+            if (str != IntPtr.Zero)
+            {
+#if PUERTS_UNSAFE
+                unsafe
+                {
+                    return new string((char*)str, 0, strlen);
+                }
+#else
+                return Marshal.PtrToStringUni(str, strlen);
+#endif
+            }
+            else
+            {
+                return null;
+            }
+        }
+
         private static string GetStringFromNative(IntPtr str, int strlen)
         {
             if (str != IntPtr.Zero)
@@ -221,6 +304,66 @@ namespace Puerts
         }
 #endif
 
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr EvalWithCodeCache(IntPtr isolate, byte[] code, string path, byte[] codeCache, int codeCacheLength, out int codeCacheRejected);
+
+        // codeCache不可用(版本、flag或源码不匹配)时会回退到源码编译，codeCacheRejected为true，调用方应重新生成cache
+        public static IntPtr EvalWithCodeCacheChecked(IntPtr isolate, string code, string path, byte[] codeCache, out bool codeCacheRejected)
+        {
+            if (code == null)
+            {
+                throw new InvalidProgramException("eval null string");
+            }
+            int rejected;
+            IntPtr result = EvalWithCodeCache(isolate, Encoding.UTF8.GetBytes(code + '\0'), path, codeCache, codeCache == null ? 0 : codeCache.Length, out rejected);
+            codeCacheRejected = rejected != 0;
+            return result;
+        }
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr CreateCodeCache(IntPtr isolate, byte[] code, string path, out int length);
+
+        public static byte[] CreateCodeCacheChecked(IntPtr isolate, string code, string path)
+        {
+            if (code == null)
+            {
+                throw new InvalidProgramException("create code cache for null string");
+            }
+            int length;
+            IntPtr ptr = CreateCodeCache(isolate, Encoding.UTF8.GetBytes(code + '\0'), path, out length);
+            if (ptr == IntPtr.Zero)
+            {
+                return null;
+            }
+            byte[] codeCache = new byte[length];
+            Marshal.Copy(ptr, codeCache, 0, length);
+            return codeCache;
+        }
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void GetCodeCacheStats(IntPtr isolate, out int produced, out int accepted, out int rejected);
+
+        // struct拷贝等小对象池的占用，index从0开始直到返回false，blockSize为0的一项是直接malloc的分配
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern bool GetSlabPoolStats(IntPtr isolate, int index, out int blockSize, out int inUse, out int highWater, out int capacity);
+
+        // kind: 0为JSFunction，1为JSObject；staleHandles是查到已失效句柄的次数
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern bool GetHandleTableStats(IntPtr isolate, int kind, out long lookups, out long allocations, out long staleHandles, out int live);
+
+        // 以下只对nodejs后端有效：开启事件驱动后可以先用HasPendingNodeTask判断，返回true再调LogicTick
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void SetNodeLoopEventDriven(IntPtr isolate, bool enable);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern bool HasPendingNodeTask(IntPtr isolate);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void GetNodeLoopStats(IntPtr isolate, out long wakeups, out long runs, out double averageLatencyMs, out double maxLatencyMs);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void ResetNodeLoopStats(IntPtr isolate);
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         // in WebGL, the prefix '_' is necessary. (Dont know why)
         public static extern int _RegisterClass(IntPtr isolate, int BaseTypeId, string fullName, IntPtr constructor, IntPtr destructor, long data);
@@ -320,6 +463,14 @@ namespace Puerts
             }
         }
 
+        // UTF-16/单字节版本直接用v8::String::NewFromTwoByte/NewFromOneByte创建，不经过UTF-8编解码
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        public static extern void ReturnUtf16String(IntPtr isolate, IntPtr info, string str, int length);
+
+        // 只能用于已知是Latin-1(一般是纯ASCII)的字符串
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void ReturnOneByteString(IntPtr isolate, IntPtr info, byte[] str, int length);
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern void ReturnBigInt(IntPtr isolate, IntPtr info, long number);
 
@@ -375,6 +526,17 @@ namespace Puerts
             return GetStringFromNative(str, strlen);
         }
 
+        // null/undefined返回IntPtr.Zero
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr GetUtf16StringFromValue(IntPtr isolate, IntPtr value, out int len, bool isByRef);
+
+        public static string GetUtf16StringFromValue(IntPtr isolate, IntPtr value, bool isByRef)
+        {
+            int strlen;
+            IntPtr str = GetUtf16StringFromValue(isolate, value, out strlen, isByRef);
+            return GetUtf16StringFromNative(str, strlen);
+        }
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern bool GetBooleanFromValue(IntPtr isolate, IntPtr value, bool isByRef);
 
@@ -441,6 +603,12 @@ namespace Puerts
         }
 #endif
 
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        public static extern void SetUtf16StringToOutValue(IntPtr isolate, IntPtr value, string str, int length);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void SetOneByteStringToOutValue(IntPtr isolate, IntPtr value, byte[] str, int length);
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern void SetBooleanToOutValue(IntPtr isolate, IntPtr value, bool b);
 
@@ -512,6 +680,12 @@ namespace Puerts
         }
 #endif
 
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        public static extern void PushUtf16StringForJSFunction(IntPtr function, string str, int length);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void PushOneByteStringForJSFunction(IntPtr function, byte[] str, int length);
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern void PushNumberForJSFunction(IntPtr function, double d);
 
@@ -527,6 +701,10 @@ namespace Puerts
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr InvokeJSFunction(IntPtr function, bool hasResult);
 
+        // 一次P/Invoke完成参数传递、调用和返回值读取，返回值字符串放不下resultData时result.offset为-1，需用GetStringFromResult读取
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr InvokeJSFunctionBatched(IntPtr function, [In] BatchValue[] args, int argCount, byte[] data, bool hasResult, ref BatchValue result, byte[] resultData, int resultDataCapacity);
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr GetFunctionLastExceptionInfo(IntPtr function, out int len);
 
@@ -563,6 +741,16 @@ namespace Puerts
             return GetStringFromNative(str, strlen);
         }
 
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr GetUtf16StringFromResult(IntPtr resultInfo, out int len);
+
+        public static string GetUtf16StringFromResult(IntPtr resultInfo)
+        {
+            int strlen;
+            IntPtr str = GetUtf16StringFromResult(resultInfo, out strlen);
+            return GetUtf16StringFromNative(str, strlen);
+        }
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern bool GetBooleanFromResult(IntPtr resultInfo);
 
@@ -637,6 +825,20 @@ namespace Puerts
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr GetArrayBufferFromResult(IntPtr function, out int length);
 
+        // 以下External版本不拷贝数据：data需要保持有效(pinned GCHandle或者native内存)直到release被调用，userData原样传回
+        // release可能在非js线程调用，对应的delegate需要一直被引用，传IntPtr.Zero表示由调用方自行管理data的生命周期
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void ReturnExternalArrayBuffer(IntPtr isolate, IntPtr info, IntPtr data, int length, IntPtr release, long userData);
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void SetExternalArrayBufferToOutValue(IntPtr isolate, IntPtr value, IntPtr data, int length, IntPtr release, long userData);
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void PushExternalArrayBufferForJSFunction(IntPtr function, IntPtr data, int length, IntPtr release, long userData);
+        // 返回的句柄在ReleaseArrayBuffer之前保证data有效，不是ArrayBuffer/TypedArray时返回IntPtr.Zero
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr AcquireArrayBufferFromValue(IntPtr isolate, IntPtr value, out IntPtr data, out int length, bool isOut);
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void ReleaseArrayBuffer(IntPtr isolate, IntPtr handle);
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr GetJSStackTrace(IntPtr isolate, out int len);
         public static string GetJSStackTrace(IntPtr isolate)
@@ -98,6 +98,30 @@ namespace PuertsIl2cpp
         [DllImport("__Internal", CallingConvention = CallingConvention.Cdecl)]
         public static extern void SetTypeInfo(IntPtr wrapData, int index, IntPtr typeId);
 
+        // 成功调用中走反射(ReflectionWrapper)和走生成wrapper的次数
+        [DllImport("__Internal", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void GetWrapperCallStats(out ulong reflectionCalls, out ulong generatedCalls);
+
+        [DllImport("__Internal", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void ResetWrapperCallStats();
+
+        // 类注册时按签名查找生成代码的次数、未命中次数和耗时(纳秒)
+        [DllImport("__Internal", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void GetWrapperLookupStats(out ulong lookups, out ulong misses, out ulong nanoseconds);
+
+        [DllImport("__Internal", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void ResetWrapperLookupStats();
+
+        // 统计有重载的方法每次调用实际执行了几次参数检查，DumpOverloadStats通过日志回调输出
+        [DllImport("__Internal", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void SetOverloadStatsEnabled(bool enabled);
+
+        [DllImport("__Internal", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void DumpOverloadStats();
+
+        [DllImport("__Internal", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void ResetOverloadStats();
+
         [DllImport("__Internal", CallingConvention = CallingConvention.Cdecl)]
         public static extern bool RegisterCSharpType(IntPtr classInfo);
 
@@ -133,6 +157,9 @@ namespace PuertsIl2cpp
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern bool LogicTick(IntPtr jsEnv);
 
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void GetCodeCacheStats(IntPtr jsEnv, out int produced, out int accepted, out int rejected);
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static object GetModuleExecutor(IntPtr apis, IntPtr NativeJsEnvPtr, Type type)
         {
@@ -338,6 +365,11 @@ namespace PuertsIl2cpp
     public delegate IntPtr pesapi_global_func(IntPtr env);
     public delegate IntPtr pesapi_get_env_private_func(IntPtr env);
     public delegate void pesapi_set_env_private_func(IntPtr env, IntPtr ptr);
+    public delegate IntPtr pesapi_eval_with_code_cache_func(IntPtr env, IntPtr code, UIntPtr code_size, string path, IntPtr code_cache, UIntPtr code_cache_size, out int code_cache_rejected);
+    public delegate IntPtr pesapi_create_code_cache_func(IntPtr env, IntPtr code, UIntPtr code_size, string path);
+    public delegate IntPtr pesapi_intern_property_key_func(IntPtr env, string key);
+    public delegate IntPtr pesapi_get_property_by_key_func(IntPtr env, IntPtr objectPtr, IntPtr key);
+    public delegate void pesapi_set_property_by_key_func(IntPtr env, IntPtr objectPtr, IntPtr key, IntPtr value);
 
     [StructLayout(LayoutKind.Sequential)]
     public struct pesapi_ffi
@@ -424,6 +456,11 @@ namespace PuertsIl2cpp
         public pesapi_global_func global;
         public pesapi_get_env_private_func get_env_private;
         public pesapi_set_env_private_func set_env_private;
+        public pesapi_eval_with_code_cache_func eval_with_code_cache;
+        public pesapi_create_code_cache_func create_code_cache;
+        public pesapi_intern_property_key_func intern_property_key;
+        public pesapi_get_property_by_key_func get_property_by_key;
+        public pesapi_set_property_by_key_func set_property_by_key;
     }
 }
 
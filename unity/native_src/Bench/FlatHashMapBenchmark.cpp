@@ -0,0 +1,116 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+// ObjectMap(void* -> value)在std::map和TFlatHashMap下的insert/find/erase耗时对比
+// 用法: FlatHashMapBenchmark [rounds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <map>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "FlatHashMap.h"
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+struct FResult
+{
+    double Insert = 0;
+    double Find = 0;
+    double Erase = 0;
+};
+
+double ElapsedNs(Clock::time_point Begin, size_t Ops)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - Begin).count() / Ops;
+}
+
+// 模拟托管堆/native堆上的对象地址：16字节对齐，大致递增但乱序
+std::vector<void*> MakeKeys(size_t Count, uint32_t Seed)
+{
+    std::vector<void*> Keys(Count);
+    uintptr_t Base = 0x7f0000000000ULL;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        Keys[i] = reinterpret_cast<void*>(Base + i * 48);
+    }
+    std::shuffle(Keys.begin(), Keys.end(), std::mt19937(Seed));
+    return Keys;
+}
+
+template <typename MapType>
+FResult Run(const std::vector<void*>& Keys, const std::vector<void*>& Lookups, size_t& Checksum)
+{
+    FResult Result;
+    MapType Map;
+
+    auto Begin = Clock::now();
+    for (size_t i = 0; i < Keys.size(); ++i)
+    {
+        Map[Keys[i]] = static_cast<int64_t>(i);
+    }
+    Result.Insert = ElapsedNs(Begin, Keys.size());
+
+    Begin = Clock::now();
+    for (size_t i = 0; i < Lookups.size(); ++i)
+    {
+        auto Iter = Map.find(Lookups[i]);
+        if (Iter != Map.end())
+        {
+            Checksum += static_cast<size_t>(Iter->second);
+        }
+    }
+    Result.Find = ElapsedNs(Begin, Lookups.size());
+
+    Begin = Clock::now();
+    for (size_t i = 0; i < Keys.size(); ++i)
+    {
+        Checksum += Map.erase(Keys[i]);
+    }
+    Result.Erase = ElapsedNs(Begin, Keys.size());
+
+    return Result;
+}
+}
+
+int main(int argc, char** argv)
+{
+    int Rounds = argc > 1 ? atoi(argv[1]) : 3;
+    if (Rounds <= 0) Rounds = 1;
+    const size_t Sizes[] = { 10000, 100000, 1000000 };
+    size_t Checksum = 0;
+
+    printf("%-10s %-14s %12s %12s %12s\n", "entries", "map", "insert ns", "find ns", "erase ns");
+    for (size_t Size : Sizes)
+    {
+        std::vector<void*> Keys = MakeKeys(Size, 1);
+        // 一半命中一半不命中
+        std::vector<void*> Lookups = MakeKeys(Size * 2, 2);
+
+        FResult StdMap, FlatMap;
+        for (int i = 0; i < Rounds; ++i)
+        {
+            FResult R1 = Run<std::map<void*, int64_t>>(Keys, Lookups, Checksum);
+            FResult R2 = Run<puerts::TFlatHashMap<void*, int64_t>>(Keys, Lookups, Checksum);
+            StdMap.Insert += R1.Insert / Rounds;
+            StdMap.Find += R1.Find / Rounds;
+            StdMap.Erase += R1.Erase / Rounds;
+            FlatMap.Insert += R2.Insert / Rounds;
+            FlatMap.Find += R2.Find / Rounds;
+            FlatMap.Erase += R2.Erase / Rounds;
+        }
+        printf("%-10zu %-14s %12.1f %12.1f %12.1f\n", Size, "std::map", StdMap.Insert, StdMap.Find, StdMap.Erase);
+        printf("%-10zu %-14s %12.1f %12.1f %12.1f\n", Size, "TFlatHashMap", FlatMap.Insert, FlatMap.Find, FlatMap.Erase);
+    }
+    printf("checksum: %zu\n", Checksum);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+// nodejs后端：100ms轮询和事件驱动(SetNodeLoopEventDriven)两种模式下的轮询线程唤醒频率和回调延迟对比
+// 用法: NodeLoopBenchmark [seconds] [frame ms]
+// 宿主以固定帧率tick，js侧跑一个5ms的setTimeout链和一段空闲期，空闲期内理想的唤醒次数接近0
+// 空闲期中途宿主再Eval一个setTimeout，检查事件驱动模式下只按HasPendingNodeTask来tick也能触发它
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <thread>
+
+extern "C"
+{
+void* CreateJSEngine(int backend);
+void DestroyJSEngine(void* Isolate);
+void* Eval(void* Isolate, const char* Code, const char* Path);
+void LogicTick(void* Isolate);
+void SetNodeLoopEventDriven(void* Isolate, int Enable);
+int HasPendingNodeTask(void* Isolate);
+double GetNumberFromResult(void* ResultInfo);
+void GetNodeLoopStats(void* Isolate, int64_t* Wakeups, int64_t* Runs, double* AverageLatencyMs, double* MaxLatencyMs);
+void ResetNodeLoopStats(void* Isolate);
+}
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+const char* Script =
+    "globalThis.__fired = 0;\n"
+    "function schedule() {\n"
+    "  setTimeout(() => {\n"
+    "    globalThis.__fired++;\n"
+    "    if (globalThis.__fired < 100) schedule();\n"
+    "  }, 5);\n"
+    "}\n"
+    "schedule();\n";
+
+void Run(bool EventDriven, double Seconds, int FrameMs)
+{
+    void* Isolate = CreateJSEngine(1);
+    SetNodeLoopEventDriven(Isolate, EventDriven ? 1 : 0);
+    if (Eval(Isolate, Script, "bench.js") == nullptr)
+    {
+        printf("eval failed\n");
+        DestroyJSEngine(Isolate);
+        return;
+    }
+    ResetNodeLoopStats(Isolate);
+
+    int Ticks = 0;
+    bool HostTimerScheduled = false;
+    auto Begin = Clock::now();
+    auto End = Begin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(Seconds));
+    auto HostTimerAt = Begin + (End - Begin) / 2;
+    while (Clock::now() < End)
+    {
+        if (!HostTimerScheduled && Clock::now() >= HostTimerAt)
+        {
+            Eval(Isolate, "setTimeout(() => { globalThis.__fired++; }, 5);", "host_timer.js");
+            HostTimerScheduled = true;
+        }
+        if (!EventDriven || HasPendingNodeTask(Isolate))
+        {
+            LogicTick(Isolate);
+            ++Ticks;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(FrameMs));
+    }
+
+    int64_t Wakeups = 0;
+    int64_t Runs = 0;
+    double AverageLatency = 0;
+    double MaxLatency = 0;
+    GetNodeLoopStats(Isolate, &Wakeups, &Runs, &AverageLatency, &MaxLatency);
+    void* Fired = Eval(Isolate, "globalThis.__fired", "fired.js");
+    printf("%-12s %10.1f %10lld %10d %12.3f %12.3f %6.0f\n", EventDriven ? "event" : "polling", Wakeups / Seconds, (long long)Runs, Ticks,
+        AverageLatency, MaxLatency, Fired ? GetNumberFromResult(Fired) : -1.0);
+    DestroyJSEngine(Isolate);
+}
+}
+
+int main(int argc, char** argv)
+{
+    double Seconds = argc > 1 ? atof(argv[1]) : 5;
+    if (Seconds <= 0) Seconds = 1;
+    int FrameMs = argc > 2 ? atoi(argv[2]) : 16;
+    if (FrameMs <= 0) FrameMs = 1;
+
+    // fired应为101：100次setTimeout链加上空闲期宿主新建的定时器
+    printf("%-12s %10s %10s %10s %12s %12s %6s\n", "mode", "wakeups/s", "uv runs", "ticks", "avg lat ms", "max lat ms", "fired");
+    Run(false, Seconds, FrameMs);
+    Run(true, Seconds, FrameMs);
+    return 0;
+}
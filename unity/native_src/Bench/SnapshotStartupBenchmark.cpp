@@ -0,0 +1,130 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+// 冷启动(CreateJSEngine + 执行bootstrap脚本)和从snapshot启动(CreateJSEngineWithSnapshot)的耗时对比，仅v8后端
+// 用法: SnapshotStartupBenchmark [rounds] [bootstrap.js]
+// 不指定脚本时用一段生成的脚本模拟框架初始化：定义一批类和函数并构造一些对象
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+extern "C"
+{
+void* CreateJSEngine(int backend);
+void* CreateJSEngineWithSnapshot(int backend, const char* SnapshotData, int SnapshotLength);
+void DestroyJSEngine(void* Isolate);
+void* Eval(void* Isolate, const char* Code, const char* Path);
+const char* CreateSnapshot(const char* BootstrapScript, const char* Path, int* Length);
+const char* GetSnapshotErrorInfo(int* Length);
+}
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+double ElapsedMs(Clock::time_point Begin)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - Begin).count();
+}
+
+std::string MakeBootstrapScript(int Classes)
+{
+    std::ostringstream Script;
+    Script << "(function(){\n";
+    Script << "var registry = {};\n";
+    for (int i = 0; i < Classes; ++i)
+    {
+        Script << "class C" << i << " { constructor(v) { this.v = v; this.name = 'C" << i << "'; }"
+               << " get value() { return this.v * " << (i + 1) << "; }"
+               << " add(o) { return new C" << i << "(this.v + o.v); } }\n";
+        Script << "registry['C" << i << "'] = C" << i << ";\n";
+    }
+    Script << "var instances = [];\n";
+    Script << "for (var k in registry) { instances.push(new registry[k](instances.length)); }\n";
+    Script << "globalThis.__registry = registry;\n";
+    Script << "globalThis.__instances = instances;\n";
+    Script << "})();\n";
+    Script << "globalThis.__snapshotProbe = Object.keys(globalThis.__registry).length;\n";
+    return Script.str();
+}
+}
+
+int main(int argc, char** argv)
+{
+    int Rounds = argc > 1 ? atoi(argv[1]) : 10;
+    if (Rounds <= 0) Rounds = 1;
+
+    std::string Bootstrap;
+    std::string Path = "bootstrap.js";
+    if (argc > 2)
+    {
+        std::ifstream File(argv[2], std::ios::binary);
+        if (!File)
+        {
+            printf("can not open %s\n", argv[2]);
+            return 1;
+        }
+        std::ostringstream Content;
+        Content << File.rdbuf();
+        Bootstrap = Content.str();
+        Path = argv[2];
+    }
+    else
+    {
+        Bootstrap = MakeBootstrapScript(2000);
+    }
+
+    auto Begin = Clock::now();
+    int SnapshotLength = 0;
+    const char* SnapshotData = CreateSnapshot(Bootstrap.c_str(), Path.c_str(), &SnapshotLength);
+    if (SnapshotData == nullptr)
+    {
+        int ErrorLength = 0;
+        const char* Error = GetSnapshotErrorInfo(&ErrorLength);
+        printf("create snapshot failed: %.*s\n", ErrorLength, Error);
+        return 1;
+    }
+    // CreateSnapshot返回的缓冲区下次调用前有效，这里拷贝一份模拟从文件读取
+    std::vector<char> Snapshot(SnapshotData, SnapshotData + SnapshotLength);
+    printf("snapshot: %d bytes, %.2f ms\n", SnapshotLength, ElapsedMs(Begin));
+
+    double Cold = 0;
+    double FromSnapshot = 0;
+    for (int i = 0; i < Rounds; ++i)
+    {
+        Begin = Clock::now();
+        void* Isolate = CreateJSEngine(0);
+        if (Eval(Isolate, Bootstrap.c_str(), Path.c_str()) == nullptr)
+        {
+            printf("eval bootstrap failed\n");
+            return 1;
+        }
+        Cold += ElapsedMs(Begin);
+        DestroyJSEngine(Isolate);
+
+        Begin = Clock::now();
+        Isolate = CreateJSEngineWithSnapshot(0, Snapshot.data(), static_cast<int>(Snapshot.size()));
+        FromSnapshot += ElapsedMs(Begin);
+        if (Isolate == nullptr ||
+            Eval(Isolate, "if (typeof globalThis.__snapshotProbe !== 'number') throw new Error('snapshot not loaded');", "probe.js") == nullptr)
+        {
+            printf("start from snapshot failed\n");
+            return 1;
+        }
+        DestroyJSEngine(Isolate);
+    }
+
+    printf("%-10s %12s\n", "startup", "avg ms");
+    printf("%-10s %12.2f\n", "cold", Cold / Rounds);
+    printf("%-10s %12.2f\n", "snapshot", FromSnapshot / Rounds);
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+// WebSocketPP每个socket自己poll和共享网络线程(WebSocketPP.dispatch)两种模式的吞吐和延迟对比
+// 用法: WebSocketBenchmark [seconds] [sockets] [inflight] [payload bytes] [port]
+// 进程内起一个websocketpp回显服务器，js侧每个socket保持inflight条消息在途，收到回显后立即再发
+// 宿主每1ms tick一次，模拟websocketpp.js里的setInterval(..., 1)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#define ASIO_STANDALONE
+#define _WEBSOCKETPP_CPP11_TYPE_TRAITS_
+#include "websocketpp/config/asio_no_tls.hpp"
+#include "websocketpp/server.hpp"
+
+extern "C"
+{
+void* CreateJSEngine(int backend);
+void DestroyJSEngine(void* Isolate);
+void* Eval(void* Isolate, const char* Code, const char* Path);
+double GetNumberFromResult(void* ResultInfo);
+}
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+typedef websocketpp::server<websocketpp::config::asio> EchoServer;
+
+const char* Script =
+    "globalThis.__bench = function(url, count, inflight, size, shared) {\n"
+    "  const state = { open: 0, received: 0, latency: 0, maxLatency: 0, sockets: [] };\n"
+    "  for (let i = 0; i < count; i++) {\n"
+    "    const raw = new WebSocketPP(url, shared);\n"
+    "    const payload = new Float64Array(Math.max(1, size >> 3));\n"
+    "    raw.setHandles(() => {\n"
+    "      state.open++;\n"
+    "      for (let k = 0; k < inflight; k++) { payload[0] = Date.now(); raw.send(payload); }\n"
+    "    }, (data) => {\n"
+    "      const now = Date.now();\n"
+    "      const latency = now - new Float64Array(data, 0, 1)[0];\n"
+    "      state.received++;\n"
+    "      state.latency += latency;\n"
+    "      if (latency > state.maxLatency) state.maxLatency = latency;\n"
+    "      payload[0] = now;\n"
+    "      raw.send(payload);\n"
+    "    }, () => {}, () => {});\n"
+    "    state.sockets.push(raw);\n"
+    "  }\n"
+    "  globalThis.__state = state;\n"
+    "  globalThis.__tick = shared ? () => WebSocketPP.dispatch() : () => { for (const raw of state.sockets) raw.poll(); };\n"
+    "  globalThis.__close = () => { for (const raw of state.sockets) raw.close(1000, ''); };\n"
+    "};\n";
+
+double EvalNumber(void* Isolate, const char* Code)
+{
+    void* Result = Eval(Isolate, Code, "bench.js");
+    return Result ? GetNumberFromResult(Result) : 0;
+}
+
+void Tick(void* Isolate)
+{
+    Eval(Isolate, "__tick()", "bench.js");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void Run(bool Shared, double Seconds, int Sockets, int Inflight, int PayloadSize, int Port)
+{
+    void* Isolate = CreateJSEngine(0);
+    char Code[256];
+    snprintf(Code, sizeof(Code), "__bench('ws://127.0.0.1:%d', %d, %d, %d, %s)", Port, Sockets, Inflight, PayloadSize,
+        Shared ? "true" : "false");
+    if (Eval(Isolate, Script, "bench.js") == nullptr || Eval(Isolate, Code, "bench.js") == nullptr)
+    {
+        printf("eval failed\n");
+        DestroyJSEngine(Isolate);
+        return;
+    }
+
+    auto Deadline = Clock::now() + std::chrono::seconds(5);
+    while (EvalNumber(Isolate, "__state.open") < Sockets && Clock::now() < Deadline)
+    {
+        Tick(Isolate);
+    }
+
+    double ReceivedBegin = EvalNumber(Isolate, "__state.received");
+    double LatencyBegin = EvalNumber(Isolate, "__state.latency");
+    auto Begin = Clock::now();
+    auto End = Begin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(Seconds));
+    while (Clock::now() < End)
+    {
+        Tick(Isolate);
+    }
+    double Elapsed = std::chrono::duration<double>(Clock::now() - Begin).count();
+
+    double Received = EvalNumber(Isolate, "__state.received") - ReceivedBegin;
+    double Latency = EvalNumber(Isolate, "__state.latency") - LatencyBegin;
+    double MaxLatency = EvalNumber(Isolate, "__state.maxLatency");
+    printf("%-10s %14.0f %12.3f %12.0f\n", Shared ? "shared" : "per-socket", Received / Elapsed, Received > 0 ? Latency / Received : 0,
+        MaxLatency);
+
+    Eval(Isolate, "__close()", "bench.js");
+    for (int i = 0; i < 50; ++i)
+    {
+        Tick(Isolate);
+    }
+    DestroyJSEngine(Isolate);
+}
+}
+
+int main(int argc, char** argv)
+{
+    double Seconds = argc > 1 ? atof(argv[1]) : 5;
+    if (Seconds <= 0) Seconds = 1;
+    int Sockets = argc > 2 ? atoi(argv[2]) : 16;
+    if (Sockets <= 0) Sockets = 1;
+    int Inflight = argc > 3 ? atoi(argv[3]) : 8;
+    if (Inflight <= 0) Inflight = 1;
+    int PayloadSize = argc > 4 ? atoi(argv[4]) : 256;
+    if (PayloadSize < 8) PayloadSize = 8;
+    int Port = argc > 5 ? atoi(argv[5]) : 19002;
+
+    EchoServer Server;
+    Server.set_access_channels(websocketpp::log::alevel::none);
+    Server.set_error_channels(websocketpp::log::elevel::none);
+    Server.init_asio();
+    Server.set_reuse_addr(true);
+    Server.set_message_handler(
+        [&Server](websocketpp::connection_hdl Handle, EchoServer::message_ptr Message)
+        {
+            websocketpp::lib::error_code ec;
+            Server.send(Handle, Message->get_payload(), Message->get_opcode(), ec);
+        });
+    Server.listen(static_cast<uint16_t>(Port));
+    Server.start_accept();
+    std::thread ServerThread([&Server]() { Server.run(); });
+
+    printf("%-10s %14s %12s %12s\n", "mode", "messages/s", "avg lat ms", "max lat ms");
+    Run(false, Seconds, Sockets, Inflight, PayloadSize, Port);
+    Run(true, Seconds, Sockets, Inflight, PayloadSize, Port);
+
+    Server.stop_listening();
+    Server.stop();
+    ServerThread.join();
+    return 0;
+}
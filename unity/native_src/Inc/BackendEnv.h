@@ -8,11 +8,15 @@
 #pragma once
 
 #include <map>
+#include <atomic>
 #include <algorithm>
 #include <unordered_map>
+#include <vector>
 #include "Common.h"
 #include "Log.h"
+#include "CodeCache.h"
 #include "V8InspectorImpl.h"
+#include "PooledArrayBufferAllocator.h"
 #if WITH_QUICKJS
 #include "quickjs-msvc.h"
 #endif
@@ -30,6 +34,26 @@
 
 namespace PUERTS_NAMESPACE
 {
+    // 只在nodejs后端有意义，轮询线程和宿主线程都会写，所以全部用atomic
+    struct FNodeLoopStats
+    {
+        // 轮询线程从等待中返回的次数
+        std::atomic<uint64_t> Wakeups{0};
+        // 宿主线程实际执行uv_run的次数
+        std::atomic<uint64_t> Runs{0};
+        // 轮询线程发现事件到宿主线程执行uv_run之间的延迟
+        std::atomic<uint64_t> LatencyMicrosecondsTotal{0};
+        std::atomic<uint64_t> LatencyMicrosecondsMax{0};
+
+        void Reset()
+        {
+            Wakeups = 0;
+            Runs = 0;
+            LatencyMicrosecondsTotal = 0;
+            LatencyMicrosecondsMax = 0;
+        }
+    };
+
     class FBackendEnv 
     {
     public:
@@ -54,6 +78,14 @@ namespace PUERTS_NAMESPACE
         
         void StopPolling();
 
+        // 开启后轮询线程按uv_backend_timeout等待，不再每100ms醒一次，宿主可以先用HasPendingTask判断是否需要LogicTick
+        void SetEventDrivenLoop(bool Enable);
+
+        // 无锁读取，可以每帧调用，需在js线程调用；有待处理的uv事件，或者js新建的定时器早于轮询线程的等待截止时间时返回true
+        bool HasPendingTask() const;
+
+        FNodeLoopStats NodeLoopStats;
+
 #if defined(WITH_NODEJS)
         uv_loop_t NodeUVLoop;
 
@@ -74,7 +106,15 @@ namespace PUERTS_NAMESPACE
         bool PollingClosed = false;
 
         // FGraphEventRef LastJob;
-        bool hasPendingTask = false;
+        std::atomic<bool> hasPendingTask{false};
+
+        std::atomic<bool> EventDrivenLoop{false};
+
+        // 轮询线程本轮等待的截止时间(steady_clock毫秒)，不在等待时为0，无限等待时为INT64_MAX
+        std::atomic<int64_t> PollDeadlineMilliseconds{0};
+
+        // 轮询线程发现事件的时间(steady_clock微秒)，用于统计延迟
+        std::atomic<int64_t> PendingSinceMicroseconds{0};
 
 #if PLATFORM_LINUX
         int Epoll;
@@ -82,8 +122,13 @@ namespace PUERTS_NAMESPACE
 
         void UvRunOnce();
 
+        int GetPollTimeout();
+
         void PollEvents();
 
+        // 宿主线程新建了比轮询线程当前等待更早到期的定时器时，唤醒轮询线程重新计算超时
+        void WakeupIfDeadlineMoved();
+
         static void OnWatcherQueueChanged(uv_loop_t* loop);
 
         void WakeupPollingThread();
@@ -108,7 +153,26 @@ namespace PUERTS_NAMESPACE
             std::map<std::string, v8::Global<v8::Module>> ResolveCache;
         };
         std::unordered_multimap<int, FModuleInfo*> ScriptIdToModuleInfo;
-        
+
+        // (referrer, specifier) -> url，避免同一条import边重复回调__puer_resolve_module_url__，ClearModuleCache时失效
+        struct FResolvedUrl
+        {
+            std::string Referrer;
+            std::string Url;
+        };
+        std::unordered_map<std::string, FResolvedUrl> ResolvedUrlCache;
+
+        struct FModuleLoadStats
+        {
+            uint32_t ResolveHits = 0;
+            uint32_t ResolveMisses = 0;
+            double ResolveMilliseconds = 0;
+            uint32_t Reads = 0;
+            double ReadMilliseconds = 0;
+        };
+        FModuleLoadStats ModuleLoadStats;
+
+        void InvalidateResolvedUrlCache(const std::string& Path);
         
         v8::MaybeLocal<v8::Value> ResolvePath(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Value> Specifier, v8::Local<v8::Value> ReferrerName);
         
@@ -138,7 +202,12 @@ namespace PUERTS_NAMESPACE
         }
         static void GlobalPrepare();
 
-        void Initialize(void* external_quickjs_runtime, void* external_quickjs_context);
+        // SnapshotData非空时从v8::SnapshotCreator生成的blob启动，blob会被拷贝一份，调用者无需保持其生命周期
+        // ExternalReferences必须和生成snapshot时传给SnapshotCreator的表完全一致
+        // PooledArrayBufferAllocator只对v8后端生效，nodejs和quickjs后端忽略
+        void Initialize(void* external_quickjs_runtime, void* external_quickjs_context,
+            const char* SnapshotData = nullptr, int SnapshotLength = 0, const intptr_t* ExternalReferences = nullptr,
+            bool PooledArrayBufferAllocator = false);
 
         void UnInitialize();
         
@@ -152,7 +221,35 @@ namespace PUERTS_NAMESPACE
 
         std::string GetJSStackTrace();
 #if !defined(WITH_QUICKJS)
-        v8::Local<v8::Object> GetV8Extras(v8::Isolate* isolate, v8::Local<v8::Context> context);
+        static v8::Local<v8::Object> GetV8Extras(v8::Isolate* isolate, v8::Local<v8::Context> context);
+
+        // 追加BackendEnv注册到js的native回调，用于构造snapshot的external references表
+        static void AppendExternalReferences(std::vector<intptr_t>& References);
+
+        // 未启用池化分配器时为空，由CreateParams->array_buffer_allocator持有
+        FPooledArrayBufferAllocator* PooledAllocator = nullptr;
+#endif
+
+        // CodeCache
+        FCodeCacheStats CodeCacheStats;
+
+        // CodeCache为空时等价于v8::Script::Compile，cache无效或被v8拒绝时回退到源码编译并通过Rejected告知调用者
+        v8::MaybeLocal<v8::Script> CompileScript(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::String> Source,
+            v8::ScriptOrigin* Origin, const uint8_t* CodeCache, size_t CodeCacheLength, bool* Rejected);
+
+        // quickjs没有code cache，总是返回false
+        bool CreateCodeCache(v8::Local<v8::Script> Script, std::vector<uint8_t>& OutData);
+
+#if !defined(WITH_QUICKJS)
+    private:
+        // isolate存活期间v8会访问snapshot数据
+        std::vector<char> SnapshotBlob;
+
+        v8::StartupData SnapshotStartupData;
+
+        uint32_t ExpectCodeCacheFlagHash = 0;
+
+        uint32_t GetExpectCodeCacheFlagHash(v8::Isolate* Isolate, v8::Local<v8::Context> Context);
 #endif
     };
 
@@ -0,0 +1,143 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if !defined(PUERTS_NAMESPACE)
+#define PUERTS_NAMESPACE puerts
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+// v8 code cache(ScriptCompiler::CachedData)的头部，布局和unity/v8cc生成的.cbc/.mbc文件一致
+// 依赖V8_MAJOR_VERSION，需要在v8头文件之后包含
+struct FCodeCacheHeader
+{
+    uint32_t MagicNumber;
+    uint32_t VersionHash;
+    uint32_t SourceHash;
+    uint32_t FlagHash;
+#if defined(V8_MAJOR_VERSION) && V8_MAJOR_VERSION >= 11
+    uint32_t ReadOnlySnapshotChecksum;
+#endif
+    uint32_t PayloadLength;
+    uint32_t Checksum;
+};
+
+struct FCodeCacheStats
+{
+    uint32_t Produced = 0;
+    uint32_t Accepted = 0;
+    uint32_t Rejected = 0;
+};
+
+// SourceHash的低31位是源码长度，最高位标记是否为esm
+static const uint32_t kCodeCacheModuleFlagMask = (1u << 31);
+
+// 只做不需要v8参与的廉价检查：长度不对或者源码长度对不上的直接判定为无效，不必交给v8再拒绝一次
+inline bool IsCodeCacheUsable(const uint8_t* Data, size_t Length, size_t SourceLength)
+{
+    if (Data == nullptr || Length < sizeof(FCodeCacheHeader))
+    {
+        return false;
+    }
+    const FCodeCacheHeader* Header = reinterpret_cast<const FCodeCacheHeader*>(Data);
+    if (static_cast<size_t>(Header->PayloadLength) + sizeof(FCodeCacheHeader) > Length)
+    {
+        return false;
+    }
+    return (Header->SourceHash & ~kCodeCacheModuleFlagMask) == static_cast<uint32_t>(SourceLength);
+}
+
+// v8cc --bundle生成的打包文件：FCodeCacheBundleHeader + 按PathHash升序的FCodeCacheBundleEntry[EntryCount] + 各cache数据(8字节对齐)
+// 整个文件可以直接mmap，用FindCodeCacheInBundle按路径查找
+static const uint32_t kCodeCacheBundleMagic = 0x42434350;    // "PCCB"
+static const uint32_t kCodeCacheBundleVersion = 1;
+
+struct FCodeCacheBundleHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t EntryCount;
+    uint32_t Reserved;
+};
+
+struct FCodeCacheBundleEntry
+{
+    uint64_t PathHash;
+    // 相对文件头的偏移
+    uint32_t Offset;
+    uint32_t Length;
+    // 同FCodeCacheHeader::SourceHash，可以在不解析cache的情况下判断源码是否变化
+    uint32_t SourceHash;
+    uint32_t Reserved;
+};
+
+// FNV-1a 64，路径需和v8cc打包时的url一致
+inline uint64_t CodeCachePathHash(const char* Path, size_t Length)
+{
+    uint64_t Hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < Length; ++i)
+    {
+        Hash ^= static_cast<uint8_t>(Path[i]);
+        Hash *= 0x100000001b3ULL;
+    }
+    return Hash;
+}
+
+inline const FCodeCacheBundleEntry* FindCodeCacheBundleEntry(const uint8_t* Bundle, size_t BundleLength, const char* Path, size_t PathLength)
+{
+    if (Bundle == nullptr || BundleLength < sizeof(FCodeCacheBundleHeader))
+    {
+        return nullptr;
+    }
+    const FCodeCacheBundleHeader* Header = reinterpret_cast<const FCodeCacheBundleHeader*>(Bundle);
+    if (Header->Magic != kCodeCacheBundleMagic || Header->Version != kCodeCacheBundleVersion ||
+        sizeof(FCodeCacheBundleHeader) + static_cast<size_t>(Header->EntryCount) * sizeof(FCodeCacheBundleEntry) > BundleLength)
+    {
+        return nullptr;
+    }
+    const FCodeCacheBundleEntry* Entries = reinterpret_cast<const FCodeCacheBundleEntry*>(Bundle + sizeof(FCodeCacheBundleHeader));
+    uint64_t Hash = CodeCachePathHash(Path, PathLength);
+    size_t Low = 0;
+    size_t High = Header->EntryCount;
+    while (Low < High)
+    {
+        size_t Mid = Low + (High - Low) / 2;
+        if (Entries[Mid].PathHash < Hash)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+    if (Low == Header->EntryCount || Entries[Low].PathHash != Hash ||
+        static_cast<size_t>(Entries[Low].Offset) + Entries[Low].Length > BundleLength)
+    {
+        return nullptr;
+    }
+    return &Entries[Low];
+}
+
+// 返回的指针指向Bundle内部，找不到返回nullptr
+inline const uint8_t* FindCodeCacheInBundle(const uint8_t* Bundle, size_t BundleLength, const char* Path, size_t PathLength, size_t* OutLength)
+{
+    const FCodeCacheBundleEntry* Entry = FindCodeCacheBundleEntry(Bundle, BundleLength, Path, PathLength);
+    if (Entry == nullptr)
+    {
+        *OutLength = 0;
+        return nullptr;
+    }
+    *OutLength = Entry->Length;
+    return Bundle + Entry->Offset;
+}
+}
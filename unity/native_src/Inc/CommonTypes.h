@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 namespace puerts
 {
 
@@ -29,6 +31,23 @@ enum JsValueType
     Unknow          = 2048,
 };
 
+// 批量调用(InvokeJSFunctionBatched)的参数/返回值槽位，C#侧按同样的16字节布局填充
+// String/ArrayBuffer: Offset为在附带数据区的字节偏移，Length为字节长度
+// NativeObject: Ptr为对象指针(C#侧传的是对象池id)，Length为ClassID
+// Function/JsObject: Ptr为JSFunction*/JSObject*
+struct FBatchValue
+{
+    int32_t Type;
+    int32_t Length;
+    union
+    {
+        double Number;
+        int64_t BigInt;
+        int64_t Boolean;
+        int64_t Offset;
+        void* Ptr;
+    };
+};
 
 }
 
@@ -0,0 +1,343 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <new>
+#include <utility>
+#include <functional>
+
+#if !defined(PUERTS_NAMESPACE)
+#define PUERTS_NAMESPACE puerts
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+template <typename K>
+struct TFlatHashMapHasher
+{
+    size_t operator()(const K& Key) const
+    {
+        return std::hash<K>()(Key);
+    }
+};
+
+// 指针低位因对齐几乎恒为0，直接取模会导致大量冲突，所以先乘一个奇数常量把高位熵扩散下来
+template <typename T>
+struct TFlatHashMapHasher<T*>
+{
+    size_t operator()(T* Key) const
+    {
+        uint64_t H = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(Key));
+        H ^= H >> 33;
+        H *= 0xff51afd7ed558ccdULL;
+        H ^= H >> 33;
+        return static_cast<size_t>(H);
+    }
+};
+
+template <>
+struct TFlatHashMapHasher<int32_t>
+{
+    size_t operator()(int32_t Key) const
+    {
+        return static_cast<size_t>(static_cast<uint32_t>(Key) * 0x9E3779B9u);
+    }
+};
+
+// 线性探测的开放寻址哈希表，删除时做backward-shift，不留墓碑
+// 接口只实现了JSEngine里用到的std::map子集：find/end/erase(key)/operator[]/遍历/size/clear
+template <typename K, typename V, typename Hasher = TFlatHashMapHasher<K>>
+class TFlatHashMap
+{
+public:
+    typedef std::pair<K, V> value_type;
+
+    template <typename MapType, typename ValueType>
+    class TIterator
+    {
+    public:
+        TIterator(MapType* InMap, size_t InIndex) : Map(InMap), Index(InIndex)
+        {
+            SkipEmpty();
+        }
+
+        ValueType& operator*() const
+        {
+            return Map->Slots[Index];
+        }
+
+        ValueType* operator->() const
+        {
+            return &Map->Slots[Index];
+        }
+
+        TIterator& operator++()
+        {
+            ++Index;
+            SkipEmpty();
+            return *this;
+        }
+
+        bool operator==(const TIterator& Other) const
+        {
+            return Index == Other.Index;
+        }
+
+        bool operator!=(const TIterator& Other) const
+        {
+            return Index != Other.Index;
+        }
+
+    private:
+        void SkipEmpty()
+        {
+            while (Index < Map->Capacity && !Map->Used[Index])
+            {
+                ++Index;
+            }
+        }
+
+        MapType* Map;
+
+        size_t Index;
+
+        friend class TFlatHashMap;
+    };
+
+    typedef TIterator<TFlatHashMap, value_type> iterator;
+
+    typedef TIterator<const TFlatHashMap, const value_type> const_iterator;
+
+    TFlatHashMap() : Slots(nullptr), Used(nullptr), Capacity(0), Count(0)
+    {
+    }
+
+    ~TFlatHashMap()
+    {
+        Release();
+    }
+
+    TFlatHashMap(const TFlatHashMap&) = delete;
+
+    TFlatHashMap& operator=(const TFlatHashMap&) = delete;
+
+    size_t size() const
+    {
+        return Count;
+    }
+
+    bool empty() const
+    {
+        return Count == 0;
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(this, Capacity);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, Capacity);
+    }
+
+    iterator find(const K& Key)
+    {
+        return iterator(this, FindIndex(Key));
+    }
+
+    const_iterator find(const K& Key) const
+    {
+        return const_iterator(this, FindIndex(Key));
+    }
+
+    V& operator[](const K& Key)
+    {
+        size_t Index = FindIndex(Key);
+        if (Index != Capacity)
+        {
+            return Slots[Index].second;
+        }
+        if ((Count + 1) * 4 > Capacity * 3)
+        {
+            Rehash(Capacity == 0 ? 16 : Capacity * 2);
+        }
+        Index = InsertSlot(Key);
+        return Slots[Index].second;
+    }
+
+    size_t erase(const K& Key)
+    {
+        size_t Index = FindIndex(Key);
+        if (Index == Capacity)
+        {
+            return 0;
+        }
+        EraseAt(Index);
+        return 1;
+    }
+
+    void erase(iterator Iter)
+    {
+        EraseAt(Iter.Index);
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+        {
+            if (Used[i])
+            {
+                Slots[i].~value_type();
+                Used[i] = 0;
+            }
+        }
+        Count = 0;
+    }
+
+    void reserve(size_t InCount)
+    {
+        size_t NewCapacity = Capacity == 0 ? 16 : Capacity;
+        while (InCount * 4 > NewCapacity * 3)
+        {
+            NewCapacity *= 2;
+        }
+        if (NewCapacity != Capacity)
+        {
+            Rehash(NewCapacity);
+        }
+    }
+
+private:
+    size_t Mask() const
+    {
+        return Capacity - 1;
+    }
+
+    size_t FindIndex(const K& Key) const
+    {
+        if (Count == 0)
+        {
+            return Capacity;
+        }
+        size_t Index = Hasher()(Key) & Mask();
+        while (Used[Index])
+        {
+            if (Slots[Index].first == Key)
+            {
+                return Index;
+            }
+            Index = (Index + 1) & Mask();
+        }
+        return Capacity;
+    }
+
+    // 调用者保证Key不存在且容量足够
+    size_t InsertSlot(const K& Key)
+    {
+        size_t Index = Hasher()(Key) & Mask();
+        while (Used[Index])
+        {
+            Index = (Index + 1) & Mask();
+        }
+        new (&Slots[Index]) value_type(Key, V());
+        Used[Index] = 1;
+        ++Count;
+        return Index;
+    }
+
+    void EraseAt(size_t Hole)
+    {
+        Slots[Hole].~value_type();
+        Used[Hole] = 0;
+        --Count;
+
+        // backward-shift：把后续探测链上"本可以放在Hole位置"的元素往前挪，保证查找不会被空位截断
+        size_t Next = Hole;
+        while (true)
+        {
+            Next = (Next + 1) & Mask();
+            if (!Used[Next])
+            {
+                break;
+            }
+            size_t Ideal = Hasher()(Slots[Next].first) & Mask();
+            if (((Next - Ideal) & Mask()) >= ((Next - Hole) & Mask()))
+            {
+                new (&Slots[Hole]) value_type(std::move(Slots[Next]));
+                Used[Hole] = 1;
+                Slots[Next].~value_type();
+                Used[Next] = 0;
+                Hole = Next;
+            }
+        }
+    }
+
+    void Rehash(size_t NewCapacity)
+    {
+        value_type* OldSlots = Slots;
+        uint8_t* OldUsed = Used;
+        size_t OldCapacity = Capacity;
+
+        Slots = static_cast<value_type*>(::operator new(sizeof(value_type) * NewCapacity));
+        Used = new uint8_t[NewCapacity]();
+        Capacity = NewCapacity;
+        Count = 0;
+
+        for (size_t i = 0; i < OldCapacity; ++i)
+        {
+            if (OldUsed[i])
+            {
+                size_t Index = Hasher()(OldSlots[i].first) & Mask();
+                while (Used[Index])
+                {
+                    Index = (Index + 1) & Mask();
+                }
+                new (&Slots[Index]) value_type(std::move(OldSlots[i]));
+                Used[Index] = 1;
+                ++Count;
+                OldSlots[i].~value_type();
+            }
+        }
+
+        ::operator delete(OldSlots);
+        delete[] OldUsed;
+    }
+
+    void Release()
+    {
+        clear();
+        ::operator delete(Slots);
+        delete[] Used;
+        Slots = nullptr;
+        Used = nullptr;
+        Capacity = 0;
+    }
+
+    value_type* Slots;
+
+    uint8_t* Used;
+
+    size_t Capacity;
+
+    size_t Count;
+};
+}
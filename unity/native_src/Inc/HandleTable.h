@@ -0,0 +1,132 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#if !defined(PUERTS_NAMESPACE)
+#define PUERTS_NAMESPACE puerts
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+struct FHandleTableStats
+{
+    uint64_t Lookups = 0;
+    uint64_t Allocations = 0;
+    // 句柄指向的槽位已经被释放或者复用
+    uint64_t StaleHandles = 0;
+};
+
+// 带代数(generation)的句柄表：句柄 = generation << 32 | index，槽位释放时generation加一，旧句柄随之失效
+// generation只保留低20位，保证句柄放进js的Number(double)里不丢精度
+// 不加锁，由调用方保证互斥
+template <typename T>
+class THandleTable
+{
+public:
+    static const uint32_t kGenerationMask = (1u << 20) - 1;
+
+    int32_t Allocate()
+    {
+        ++Stats.Allocations;
+        int32_t Index;
+        if (FreeHead >= 0)
+        {
+            Index = FreeHead;
+            FreeHead = Slots[Index].NextFree;
+        }
+        else
+        {
+            Index = static_cast<int32_t>(Slots.size());
+            Slots.emplace_back();
+        }
+        Slots[Index].NextFree = -1;
+        ++Live;
+        return Index;
+    }
+
+    void Assign(int32_t Index, T* Ptr)
+    {
+        Slots[Index].Ptr = Ptr;
+    }
+
+    void Free(int32_t Index)
+    {
+        FSlot& Slot = Slots[Index];
+        Slot.Ptr = nullptr;
+        Slot.Generation = (Slot.Generation + 1) & kGenerationMask;
+        Slot.NextFree = FreeHead;
+        FreeHead = Index;
+        --Live;
+    }
+
+    int64_t ToHandle(int32_t Index) const
+    {
+        return (static_cast<int64_t>(Slots[Index].Generation) << 32) | static_cast<uint32_t>(Index);
+    }
+
+    // 句柄失效时返回nullptr并计入StaleHandles
+    T* Find(int64_t Handle)
+    {
+        ++Stats.Lookups;
+        uint32_t Index = static_cast<uint32_t>(Handle);
+        uint32_t Generation = static_cast<uint32_t>(Handle >> 32);
+        if (Index >= Slots.size() || Slots[Index].Generation != Generation || Slots[Index].Ptr == nullptr)
+        {
+            ++Stats.StaleHandles;
+            return nullptr;
+        }
+        return Slots[Index].Ptr;
+    }
+
+    template <typename F>
+    void ForEach(F&& Func) const
+    {
+        for (const FSlot& Slot : Slots)
+        {
+            if (Slot.Ptr)
+            {
+                Func(Slot.Ptr);
+            }
+        }
+    }
+
+    int32_t LiveCount() const
+    {
+        return Live;
+    }
+
+    const FHandleTableStats& GetStats() const
+    {
+        return Stats;
+    }
+
+    void ResetStats()
+    {
+        Stats = FHandleTableStats();
+    }
+
+private:
+    struct FSlot
+    {
+        T* Ptr = nullptr;
+        uint32_t Generation = 0;
+        int32_t NextFree = -1;
+    };
+
+    std::vector<FSlot> Slots;
+
+    int32_t FreeHead = -1;
+
+    int32_t Live = 0;
+
+    FHandleTableStats Stats;
+};
+}
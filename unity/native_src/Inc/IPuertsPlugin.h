@@ -24,6 +24,24 @@ public:
 
     virtual void* Eval(const char *Code, const char* Path) = 0;
 
+    virtual void* EvalWithCodeCache(const char *Code, const char* Path, const uint8_t* CodeCache, int CodeCacheLength, int *CodeCacheRejected) = 0;
+
+    virtual const uint8_t* CreateCodeCache(const char *Code, const char* Path, int *Length) = 0;
+
+    virtual void GetCodeCacheStats(int *Produced, int *Accepted, int *Rejected) = 0;
+
+    virtual bool GetSlabPoolStats(int Index, int *BlockSize, int *InUse, int *HighWater, int *Capacity) = 0;
+
+    virtual bool GetHandleTableStats(int Kind, int64_t *Lookups, int64_t *Allocations, int64_t *StaleHandles, int *Live) = 0;
+
+    virtual void SetNodeLoopEventDriven(int Enable) = 0;
+
+    virtual int HasPendingNodeTask() = 0;
+
+    virtual void GetNodeLoopStats(int64_t *Wakeups, int64_t *Runs, double *AverageLatencyMs, double *MaxLatencyMs) = 0;
+
+    virtual void ResetNodeLoopStats() = 0;
+
     virtual bool ClearModuleCache(const char* Path) = 0;
     
     virtual int RegisterClass(int BaseTypeId, const char *FullName, FuncPtr Constructor, FuncPtr Destructor, int64_t Data, int Size) = 0;
@@ -70,6 +88,12 @@ public:
 
     virtual void SetStringToOutValue(void* Value, const char *Str) = 0;
 
+    virtual const uint16_t *GetUtf16StringFromValue(void* Value, int *Length, int IsOut) = 0;
+
+    virtual void SetUtf16StringToOutValue(void* Value, const uint16_t *Str, int Length) = 0;
+
+    virtual void SetOneByteStringToOutValue(void* Value, const uint8_t *Str, int Length) = 0;
+
     virtual int GetBooleanFromValue(void* Value, int IsOut) = 0;
 
     virtual void SetBooleanToOutValue(void* Value, int B) = 0;
@@ -84,6 +108,12 @@ public:
 
     virtual void SetArrayBufferToOutValue(void* Value, unsigned char *Bytes, int Length) = 0;
 
+    virtual void* AcquireArrayBufferFromValue(void* Value, void **Data, int *Length, int IsOut) = 0;
+
+    virtual void ReleaseArrayBuffer(void *Handle) = 0;
+
+    virtual void SetExternalArrayBufferToOutValue(void* Value, void *Data, int Length, FuncPtr Release, int64_t UserData) = 0;
+
     virtual void *GetObjectFromValue(void* Value, int IsOut) = 0;
 
     virtual int GetTypeIdFromValue(void* Value, int IsOut) = 0;
@@ -110,10 +140,16 @@ public:
 
     virtual void ReturnString(const void* Info, const char* String) = 0;
 
+    virtual void ReturnUtf16String(const void* Info, const uint16_t* String, int Length) = 0;
+
+    virtual void ReturnOneByteString(const void* Info, const uint8_t* String, int Length) = 0;
+
     virtual void ReturnBigInt(const void* Info, int64_t BigInt) = 0;
 
     virtual void ReturnArrayBuffer(const void* Info, unsigned char *Bytes, int Length) = 0;
 
+    virtual void ReturnExternalArrayBuffer(const void* Info, void *Data, int Length, FuncPtr Release, int64_t UserData) = 0;
+
     virtual void ReturnBoolean(const void* Info, int Bool) = 0;
 
     virtual void ReturnDate(const void* Info, double Date) = 0;
@@ -139,8 +175,14 @@ public:
 
     virtual void PushArrayBufferForJSFunction(void* Function, unsigned char * Bytes, int Length) = 0;
 
+    virtual void PushExternalArrayBufferForJSFunction(void* Function, void *Data, int Length, FuncPtr Release, int64_t UserData) = 0;
+
     virtual void PushStringForJSFunction(void* Function, const char* S) = 0;
 
+    virtual void PushUtf16StringForJSFunction(void* Function, const uint16_t* S, int Length) = 0;
+
+    virtual void PushOneByteStringForJSFunction(void* Function, const uint8_t* S, int Length) = 0;
+
     virtual void PushNumberForJSFunction(void* Function, double D) = 0;
 
     virtual void PushObjectForJSFunction(void* Function, int ClassID, void* Ptr) = 0;
@@ -151,6 +193,8 @@ public:
 
     virtual void* InvokeJSFunction(void* Function, int HasResult) = 0;
 
+    virtual void* InvokeJSFunctionBatched(void* Function, const FBatchValue* Args, int ArgCount, const char* Data, int HasResult, FBatchValue* Result, char* ResultData, int ResultDataCapacity) = 0;
+
     virtual JsValueType GetResultType(void* ResultInfo) = 0;
 
     virtual double GetNumberFromResult(void* ResultInfo) = 0;
@@ -159,6 +203,8 @@ public:
 
     virtual const char *GetStringFromResult(void* ResultInfo, int *Length) = 0;
 
+    virtual const uint16_t *GetUtf16StringFromResult(void* ResultInfo, int *Length) = 0;
+
     virtual int GetBooleanFromResult(void* ResultInfo) = 0;
 
     virtual int ResultIsBigInt(void* ResultInfo) = 0;
@@ -207,6 +253,13 @@ struct PuertsPluginStore
 
 IPuertsPlugin* CreateV8Plugin(void* external_quickjs_runtime, void* external_quickjs_context);
 
+IPuertsPlugin* CreateV8PluginWithSnapshot(const char* SnapshotData, int SnapshotLength);
+
+IPuertsPlugin* CreateV8PluginWithPooledAllocator();
+
+// 返回的指针在下次调用前有效，失败返回nullptr，错误信息通过Error返回
+const char* CreateV8Snapshot(const char* BootstrapScript, const char* Path, int* Length, const char** Error);
+
 IPuertsPlugin* CreateQJSPlugin(void* external_quickjs_runtime, void* external_quickjs_context);
 
 }
\ No newline at end of file
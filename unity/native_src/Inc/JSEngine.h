@@ -18,6 +18,11 @@
 #include "JSFunction.h"
 #include "V8InspectorImpl.h"
 #include "BackendEnv.h"
+#include "SlabAllocator.h"
+#include "HandleTable.h"
+#ifdef PUERTS_FLAT_HASH_MAP
+#include "FlatHashMap.h"
+#endif
 #ifdef MULT_BACKENDS
 #include "IPuertsPlugin.h"
 #endif
@@ -32,6 +37,14 @@
 
 namespace PUERTS_NAMESPACE
 {
+#ifdef PUERTS_FLAT_HASH_MAP
+template <typename K, typename V>
+using TObjectMap = TFlatHashMap<K, V>;
+#else
+template <typename K, typename V>
+using TObjectMap = std::map<K, V>;
+#endif
+
 typedef char* (*CSharpModuleResolveCallback)(const char* identifer, int32_t jsEnvIdx, char*& pathForDebug);
 
 #ifdef MULT_BACKENDS
@@ -46,6 +59,8 @@ typedef void* (*CSharpConstructorCallback)(v8::Isolate* Isolate, const v8::Funct
 
 typedef void(*CSharpDestructorCallback)(void* Self, int64_t UserData);
 
+typedef void(*CSharpExternalBufferRelease)(void* Data, int64_t UserData);
+
 struct FCallbackInfo
 {
     FCallbackInfo(bool InIsStatic, CSharpFunctionCallback InCallback, int64_t InData) : IsStatic(InIsStatic), Callback(InCallback), Data(InData) {}
@@ -67,6 +82,19 @@ struct FLifeCycleInfo
 
 v8::Local<v8::ArrayBuffer> NewArrayBuffer(v8::Isolate* Isolate, void *Ptr, size_t Size);
 
+// 直接在调用方的内存上创建ArrayBuffer，不拷贝，Ptr在Release被调用前必须一直有效
+// Release在ArrayBuffer被gc或者isolate销毁时调用，可能不在js线程上，Release为空表示由调用方自己管理生命周期
+v8::Local<v8::ArrayBuffer> NewExternalArrayBuffer(v8::Isolate* Isolate, void *Ptr, size_t Size, CSharpExternalBufferRelease Release, int64_t UserData);
+
+// 持有Value(ArrayBuffer或ArrayBufferView)的backing store，ReleaseArrayBuffer之前Data一直有效，即使js侧的对象已经被gc
+// 不是ArrayBuffer/ArrayBufferView时返回nullptr
+void* AcquireArrayBuffer(v8::Value *Value, void** Data, int *Length);
+
+void ReleaseArrayBuffer(void* Handle);
+
+// Value转成字符串后以UTF-16写入Buffer(不带结尾的0)，非字符串只做一次ToString；null/undefined或者转换失败返回nullptr
+const uint16_t* ToUtf16(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Value *Value, std::vector<uint16_t>& Buffer, int *Length);
+
 enum JSEngineBackend
 {
     V8          = 0,
@@ -82,9 +110,20 @@ private:
 #endif
 public:
 #ifdef MULT_BACKENDS
-    JSEngine(puerts::IPuertsPlugin* InPuertsPlugin, void* external_quickjs_runtime, void* external_quickjs_context);
+    JSEngine(puerts::IPuertsPlugin* InPuertsPlugin, void* external_quickjs_runtime, void* external_quickjs_context,
+        const char* SnapshotData = nullptr, int SnapshotLength = 0, bool PooledArrayBufferAllocator = false);
 #else
-    JSEngine(void* external_quickjs_runtime, void* external_quickjs_context);
+    JSEngine(void* external_quickjs_runtime, void* external_quickjs_context,
+        const char* SnapshotData = nullptr, int SnapshotLength = 0, bool PooledArrayBufferAllocator = false);
+#endif
+
+    // 在一个临时isolate里执行BootstrapScript并生成startup snapshot，仅v8后端支持
+    // 脚本执行时只有__tgjsEvalScript和v8两个native接口可用，不能访问C#
+    static bool CreateSnapshot(const char* BootstrapScript, const char* Path, std::vector<char>& OutBlob, std::string& OutError);
+
+#if !WITH_QUICKJS
+    // 生成和加载snapshot共用的external references表，以0结尾
+    static const intptr_t* GetExternalReferences();
 #endif
 
     ~JSEngine();
@@ -93,6 +132,14 @@ public:
 
     bool Eval(const char *Code, const char* Path);
 
+    // CodeCacheRejected可为空；cache不可用时仍然会从源码编译执行，只有编译/执行出错才返回false
+    bool EvalWithCodeCache(const char *Code, const char* Path, const uint8_t* CodeCache, int CodeCacheLength, bool* CodeCacheRejected);
+
+    // 只编译不执行，结果放在CodeCacheBuffer
+    bool CreateCodeCache(const char *Code, const char* Path);
+
+    std::vector<uint8_t> CodeCacheBuffer;
+
     int RegisterClass(const char *FullName, int BaseTypeId, CSharpConstructorCallback Constructor, CSharpDestructorCallback Destructor, int64_t Data, int Size);
 
     bool RegisterFunction(int ClassID, const char *Name, bool IsStatic, CSharpFunctionCallback Callback, int64_t Data);
@@ -144,6 +191,8 @@ public:
 
     std::vector<char> StrBuffer;
 
+    std::vector<uint16_t> Utf16Buffer;
+
     FResultInfo ResultInfo;
 
     v8::UniquePersistent<v8::Function> JsPromiseRejectCallback;
@@ -156,6 +205,9 @@ public:
     int32_t Idx;
 
     FBackendEnv BackendEnv;
+
+    // struct拷贝和FCallbackInfo/FLifeCycleInfo都从这里分配，需要比它们活得更久
+    FSlabAllocator SlabAllocator;
     
 private:
     std::vector<FCallbackInfo*> CallbackInfos;
@@ -166,25 +218,32 @@ private:
 
     std::vector<v8::UniquePersistent<v8::Map>> Metadatas;
 
-    std::map<std::string, int> NameToTemplateID;
+    TObjectMap<std::string, int> NameToTemplateID;
 
-    std::map<void*, v8::UniquePersistent<v8::Value>> ObjectMap;
+    TObjectMap<void*, v8::UniquePersistent<v8::Value>> ObjectMap;
 
-    std::vector<JSFunction*> JSFunctions;
+    // js对象 -> 句柄，句柄在JSFunctions/JSObjects里O(1)查找
+    v8::UniquePersistent<v8::Map> JSFunctionIdMap;
 
-    v8::UniquePersistent<v8::Map> JSObjectIdMap;
+    THandleTable<JSFunction> JSFunctions;
 
-    std::map<int32_t, JSObject*> JSObjectMap;
+    v8::UniquePersistent<v8::Map> JSObjectIdMap;
 
-    std::vector<int32_t> ObjectMapFreeIndex;
+    THandleTable<JSObject> JSObjects;
 
     std::mutex JSFunctionsMutex;
 
     std::mutex JSObjectsMutex;
 
     JSFunction* ModuleExecutor = nullptr;
+
+    template <typename T>
+    T* FindByIdMap(THandleTable<T>& Table, v8::Local<v8::Map> IdMap, v8::Local<v8::Context> Context, v8::Local<v8::Value> Key);
     
 public:
+    // Kind: 0为JSFunction，1为JSObject
+    bool GetHandleTableStats(int Kind, FHandleTableStats* OutStats, int* OutLive);
+
     JSFunction* JSObjectValueGetter = nullptr;
 
     JSFunction* GetModuleExecutor();
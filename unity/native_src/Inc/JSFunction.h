@@ -16,8 +16,6 @@
 
 #include "V8Utils.h"
 
-#define FUNCTION_INDEX_KEY  "_psid"
-
 namespace PUERTS_NAMESPACE
 {
 class JSObject
@@ -79,6 +77,9 @@ public:
 
     bool Invoke(bool HasResult);
 
+    // 参数一次性从Args/Data转换，不经过Arguments；ResultSlot非空时把返回值直接写回调用方提供的缓冲
+    bool InvokeBatched(const puerts::FBatchValue* Args, int ArgCount, const char* Data, bool HasResult, puerts::FBatchValue* ResultSlot, char* ResultData, int ResultDataCapacity);
+
     std::vector<FValue> Arguments;
 
     v8::UniquePersistent<v8::Function> GFunction;
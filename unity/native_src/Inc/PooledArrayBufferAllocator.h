@@ -0,0 +1,87 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+#pragma once
+
+#if !defined(WITH_QUICKJS)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <mutex>
+#include <vector>
+#include "Common.h"
+
+namespace PUERTS_NAMESPACE
+{
+struct FArrayBufferAllocatorStats
+{
+    // 正在被ArrayBuffer使用的字节数(按块大小计)
+    uint64_t AllocatedBytes = 0;
+    // 空闲链表里待复用的字节数
+    uint64_t PooledBytes = 0;
+    uint64_t PeakBytes = 0;
+    // 超过最大块大小、直接向系统申请页的字节数，包含在AllocatedBytes里
+    uint64_t LargeBytes = 0;
+    uint64_t Allocations = 0;
+    // 从空闲链表直接拿到块的次数
+    uint64_t PoolHits = 0;
+};
+
+// 给protocol解码这类大量小ArrayBuffer的场景用：小块按2的幂(16~8K)分级放在空闲链表复用，大块直接mmap/VirtualAlloc
+// v8可能在后台线程释放backing store，所以需要加锁；AllocateUninitialized不清零
+class FPooledArrayBufferAllocator : public v8::ArrayBuffer::Allocator
+{
+public:
+    static const int kMinBlockShift = 4;
+    static const int kClassCount = 10;
+    static const size_t kMaxBlockSize = static_cast<size_t>(1) << (kMinBlockShift + kClassCount - 1);
+    static const size_t kChunkSize = 64 * 1024;
+
+    FPooledArrayBufferAllocator() = default;
+
+    ~FPooledArrayBufferAllocator() override;
+
+    void* Allocate(size_t Length) override;
+
+    void* AllocateUninitialized(size_t Length) override;
+
+    void Free(void* Data, size_t Length) override;
+
+    FArrayBufferAllocatorStats GetStats();
+
+private:
+    struct FFreeBlock
+    {
+        FFreeBlock* Next;
+    };
+
+    static size_t BlockSize(int Index)
+    {
+        return static_cast<size_t>(1) << (kMinBlockShift + Index);
+    }
+
+    static int ClassIndex(size_t Length);
+
+    void* AllocateSmall(int Index);
+
+    void* AllocateLarge(size_t Length);
+
+    void FreeLarge(void* Data, size_t Length);
+
+    void TrackAllocated(uint64_t Bytes);
+
+    std::mutex Mutex;
+
+    FFreeBlock* FreeLists[kClassCount] = {};
+
+    std::vector<void*> Chunks;
+
+    FArrayBufferAllocatorStats Stats;
+};
+}
+
+#endif
@@ -0,0 +1,195 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if !defined(PUERTS_NAMESPACE)
+#define PUERTS_NAMESPACE puerts
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+struct FSlabPoolStats
+{
+    // 0表示超过最大块大小、直接走malloc的分配
+    uint32_t BlockSize = 0;
+    uint32_t InUse = 0;
+    uint32_t HighWater = 0;
+    // 已经向系统申请的块数，malloc分配的这一项为0
+    uint32_t Capacity = 0;
+};
+
+// 按2的幂分级(8~256字节)的定长块池，给绑定到js的struct拷贝以及FCallbackInfo/FLifeCycleInfo使用
+// 释放的块只回到空闲链表，随JSEngine一起销毁；不加锁，只能在isolate所在线程使用
+class FSlabAllocator
+{
+public:
+    static const int kMinBlockShift = 3;
+    static const int kClassCount = 6;
+    static const size_t kMaxBlockSize = static_cast<size_t>(1) << (kMinBlockShift + kClassCount - 1);
+    static const size_t kChunkSize = 16 * 1024;
+
+    FSlabAllocator() = default;
+
+    FSlabAllocator(const FSlabAllocator&) = delete;
+
+    FSlabAllocator& operator=(const FSlabAllocator&) = delete;
+
+    ~FSlabAllocator()
+    {
+        for (auto Chunk : Chunks)
+        {
+            free(Chunk);
+        }
+    }
+
+    void* Allocate(size_t Size)
+    {
+        if (Size == 0 || Size > kMaxBlockSize)
+        {
+            Track(Large);
+            return malloc(Size);
+        }
+        int Index = ClassIndex(Size);
+        FSizeClass& Class = Classes[Index];
+        if (Class.FreeList == nullptr && !Grow(Class, BlockSize(Index)))
+        {
+            return nullptr;
+        }
+        FFreeBlock* Block = Class.FreeList;
+        Class.FreeList = Block->Next;
+        Track(Class.Stats);
+        return Block;
+    }
+
+    // Size需要和Allocate时一致
+    void Free(void* Ptr, size_t Size)
+    {
+        if (Ptr == nullptr)
+        {
+            return;
+        }
+        if (Size == 0 || Size > kMaxBlockSize)
+        {
+            --Large.InUse;
+            free(Ptr);
+            return;
+        }
+        FSizeClass& Class = Classes[ClassIndex(Size)];
+        FFreeBlock* Block = static_cast<FFreeBlock*>(Ptr);
+        Block->Next = Class.FreeList;
+        Class.FreeList = Block;
+        --Class.Stats.InUse;
+    }
+
+    template <typename T, typename... Args>
+    T* New(Args&&... InArgs)
+    {
+        void* Ptr = Allocate(sizeof(T));
+        if (!Ptr)
+        {
+            return nullptr;
+        }
+        return new (Ptr) T(std::forward<Args>(InArgs)...);
+    }
+
+    template <typename T>
+    void Delete(T* Ptr)
+    {
+        if (Ptr)
+        {
+            Ptr->~T();
+            Free(Ptr, sizeof(T));
+        }
+    }
+
+    // 0 ~ kClassCount-1为各级块池，kClassCount为malloc分配
+    static int StatsCount()
+    {
+        return kClassCount + 1;
+    }
+
+    FSlabPoolStats GetStats(int Index) const
+    {
+        if (Index < kClassCount)
+        {
+            FSlabPoolStats Stats = Classes[Index].Stats;
+            Stats.BlockSize = static_cast<uint32_t>(BlockSize(Index));
+            return Stats;
+        }
+        return Large;
+    }
+
+private:
+    struct FFreeBlock
+    {
+        FFreeBlock* Next;
+    };
+
+    struct FSizeClass
+    {
+        FFreeBlock* FreeList = nullptr;
+        FSlabPoolStats Stats;
+    };
+
+    static size_t BlockSize(int Index)
+    {
+        return static_cast<size_t>(1) << (kMinBlockShift + Index);
+    }
+
+    static int ClassIndex(size_t Size)
+    {
+        int Index = 0;
+        for (size_t Rest = (Size - 1) >> kMinBlockShift; Rest != 0; Rest >>= 1)
+        {
+            ++Index;
+        }
+        return Index;
+    }
+
+    static void Track(FSlabPoolStats& Stats)
+    {
+        if (++Stats.InUse > Stats.HighWater)
+        {
+            Stats.HighWater = Stats.InUse;
+        }
+    }
+
+    bool Grow(FSizeClass& Class, size_t Block)
+    {
+        // malloc的结果按16字节对齐，16字节及以上的块也都保持16字节对齐
+        char* Chunk = static_cast<char*>(malloc(kChunkSize));
+        if (Chunk == nullptr)
+        {
+            return false;
+        }
+        Chunks.push_back(Chunk);
+        size_t Count = kChunkSize / Block;
+        for (size_t i = Count; i > 0; --i)
+        {
+            FFreeBlock* FreeBlock = reinterpret_cast<FFreeBlock*>(Chunk + (i - 1) * Block);
+            FreeBlock->Next = Class.FreeList;
+            Class.FreeList = FreeBlock;
+        }
+        Class.Stats.Capacity += static_cast<uint32_t>(Count);
+        return true;
+    }
+
+    FSizeClass Classes[kClassCount];
+
+    FSlabPoolStats Large;
+
+    std::vector<char*> Chunks;
+};
+}
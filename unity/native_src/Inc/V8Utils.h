@@ -9,6 +9,7 @@
 
 #include <string>
 #include <sstream>
+#include <vector>
 #include "Common.h"
 
 namespace PUERTS_NAMESPACE
@@ -43,6 +44,134 @@ public:
         return v8::String::NewFromUtf8(Isolate, String, v8::NewStringType::kNormal).ToLocalChecked();
     }
 
+#if defined(WITH_QUICKJS)
+    // quickjs后端没有NewFromTwoByte/NewFromOneByte/String::Write(uint16_t*)，UTF-16和Latin-1都转成UTF-8处理
+    static void AppendUtf8(std::string& Out, uint32_t CodePoint)
+    {
+        if (CodePoint < 0x80)
+        {
+            Out.push_back(static_cast<char>(CodePoint));
+        }
+        else if (CodePoint < 0x800)
+        {
+            Out.push_back(static_cast<char>(0xC0 | (CodePoint >> 6)));
+            Out.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+        }
+        else if (CodePoint < 0x10000)
+        {
+            Out.push_back(static_cast<char>(0xE0 | (CodePoint >> 12)));
+            Out.push_back(static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F)));
+            Out.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+        }
+        else
+        {
+            Out.push_back(static_cast<char>(0xF0 | (CodePoint >> 18)));
+            Out.push_back(static_cast<char>(0x80 | ((CodePoint >> 12) & 0x3F)));
+            Out.push_back(static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F)));
+            Out.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+        }
+    }
+
+    // 不成对的代理项按U+FFFD处理
+    static std::string Utf16ToUtf8(const uint16_t* String, int Length)
+    {
+        std::string Out;
+        Out.reserve(Length);
+        for (int i = 0; i < Length; ++i)
+        {
+            uint32_t CodeUnit = String[i];
+            if (CodeUnit >= 0xD800 && CodeUnit <= 0xDBFF && i + 1 < Length && String[i + 1] >= 0xDC00 && String[i + 1] <= 0xDFFF)
+            {
+                AppendUtf8(Out, 0x10000 + ((CodeUnit - 0xD800) << 10) + (String[i + 1] - 0xDC00));
+                ++i;
+            }
+            else
+            {
+                AppendUtf8(Out, (CodeUnit >= 0xD800 && CodeUnit <= 0xDFFF) ? 0xFFFD : CodeUnit);
+            }
+        }
+        return Out;
+    }
+
+    static std::string Latin1ToUtf8(const uint8_t* String, int Length)
+    {
+        std::string Out;
+        Out.reserve(Length);
+        for (int i = 0; i < Length; ++i)
+        {
+            AppendUtf8(Out, String[i]);
+        }
+        return Out;
+    }
+
+    // 非法的UTF-8字节按U+FFFD处理
+    static void Utf8ToUtf16(const char* String, size_t Length, std::vector<uint16_t>& Out)
+    {
+        Out.clear();
+        Out.reserve(Length);
+        const uint8_t* Pos = reinterpret_cast<const uint8_t*>(String);
+        const uint8_t* End = Pos + Length;
+        while (Pos < End)
+        {
+            uint32_t Lead = *Pos++;
+            int Trail = Lead < 0x80 ? 0 : (Lead >> 5) == 0x6 ? 1 : (Lead >> 4) == 0xE ? 2 : (Lead >> 3) == 0x1E ? 3 : -1;
+            if (Trail < 0 || End - Pos < Trail)
+            {
+                Out.push_back(0xFFFD);
+                continue;
+            }
+            uint32_t CodePoint = Trail == 0 ? Lead : (Lead & (0x3F >> Trail));
+            bool Valid = true;
+            for (int i = 0; i < Trail; ++i)
+            {
+                if ((Pos[i] & 0xC0) != 0x80)
+                {
+                    Valid = false;
+                    break;
+                }
+                CodePoint = (CodePoint << 6) | (Pos[i] & 0x3F);
+            }
+            if (!Valid)
+            {
+                Out.push_back(0xFFFD);
+                continue;
+            }
+            Pos += Trail;
+            if (CodePoint >= 0x10000)
+            {
+                CodePoint -= 0x10000;
+                Out.push_back(static_cast<uint16_t>(0xD800 + (CodePoint >> 10)));
+                Out.push_back(static_cast<uint16_t>(0xDC00 + (CodePoint & 0x3FF)));
+            }
+            else
+            {
+                Out.push_back(static_cast<uint16_t>(CodePoint));
+            }
+        }
+    }
+#endif
+
+    V8_INLINE static v8::Local<v8::String> V8Utf16String(v8::Isolate* Isolate, const uint16_t* String, int Length)
+    {
+#if defined(WITH_QUICKJS)
+        std::string Utf8 = Utf16ToUtf8(String, Length);
+        return v8::String::NewFromUtf8(Isolate, Utf8.c_str(), v8::NewStringType::kNormal, static_cast<int>(Utf8.size())).ToLocalChecked();
+#else
+        return v8::String::NewFromTwoByte(Isolate, String, v8::NewStringType::kNormal, Length).ToLocalChecked();
+#endif
+    }
+
+    // 调用方保证是Latin-1(一般是纯ASCII)，省掉UTF-8解码
+    V8_INLINE static v8::Local<v8::String> V8OneByteString(v8::Isolate* Isolate, const uint8_t* String, int Length)
+    {
+#if defined(WITH_QUICKJS)
+        std::string Utf8 = Latin1ToUtf8(String, Length);
+        return v8::String::NewFromUtf8(Isolate, Utf8.c_str(), v8::NewStringType::kNormal, static_cast<int>(Utf8.size())).ToLocalChecked();
+#else
+        return v8::String::NewFromOneByte(Isolate, String, v8::NewStringType::kNormal, Length).ToLocalChecked();
+#endif
+    }
+
     V8_INLINE static std::string ExceptionToString(v8::Isolate* Isolate, v8::Local<v8::Value> ExceptionValue)
     {
 #ifdef THREAD_SAFE
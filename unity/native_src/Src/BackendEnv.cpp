@@ -8,6 +8,7 @@
 #include "Log.h"
 #include "PromiseRejectCallback.hpp"
 #include "V8Utils.h"
+#include <chrono>
 
 #if WITH_NODEJS
 
@@ -41,6 +42,8 @@
 
 #if defined(WITH_WEBSOCKET)
 void InitWebsocketPPWrap(v8::Local<v8::Context> Context);
+
+void UnInitWebsocketPPWrap(v8::Isolate* Isolate);
 #endif
 
 namespace PUERTS_NAMESPACE
@@ -51,6 +54,12 @@ static std::unique_ptr<v8::Platform> GPlatform;
 static std::vector<std::string>* Args;
 static std::vector<std::string>* ExecArgs;
 static std::vector<std::string>* Errors;
+
+static int64_t SteadyNow(int64_t Scale)
+{
+    auto Elapsed = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(Elapsed).count() / Scale;
+}
 #endif
 
 void FBackendEnv::StartPolling()
@@ -71,10 +80,13 @@ void FBackendEnv::StartPolling()
                     break;
 
                 self->PollEvents();
+                self->PollDeadlineMilliseconds = 0;
+                ++self->NodeLoopStats.Wakeups;
 
                 if (self->PollingClosed)
                     break;
 
+                self->PendingSinceMicroseconds = SteadyNow(1);
                 self->hasPendingTask = true;
             }
         },
@@ -120,6 +132,18 @@ void FBackendEnv::UvRunOnce()
     auto Context = MainContext.Get(Isolate);
     v8::Context::Scope ContextScope(Context);
 
+    int64_t PendingSince = PendingSinceMicroseconds.exchange(0);
+    if (PendingSince > 0)
+    {
+        uint64_t Latency = static_cast<uint64_t>(SteadyNow(1) - PendingSince);
+        NodeLoopStats.LatencyMicrosecondsTotal += Latency;
+        if (Latency > NodeLoopStats.LatencyMicrosecondsMax)
+        {
+            NodeLoopStats.LatencyMicrosecondsMax = Latency;
+        }
+    }
+    ++NodeLoopStats.Runs;
+
     // TODO: catch uv_run可以让脚本错误不至于进程退出，但这不知道会不会对node有什么副作用
     v8::TryCatch TryCatch(Isolate);
 
@@ -139,24 +163,48 @@ void FBackendEnv::UvRunOnce()
     uv_sem_post(&PollingSem);
 }
 
+int FBackendEnv::GetPollTimeout()
+{
+    int timeout = uv_backend_timeout(&NodeUVLoop);
+    if (!EventDrivenLoop)
+    {
+        return (timeout > 100 || timeout < 0) ? 100 : timeout;
+    }
+    // 没有活跃的定时器和io时无限等待，由uv_async_send(新的watcher、StopPolling、WakeupIfDeadlineMoved)唤醒
+    PollDeadlineMilliseconds = timeout < 0 ? INT64_MAX : SteadyNow(1000) + timeout;
+    return timeout;
+}
+
+void FBackendEnv::WakeupIfDeadlineMoved()
+{
+    int64_t Deadline = PollDeadlineMilliseconds;
+    if (Deadline == 0)
+    {
+        return;
+    }
+    int timeout = uv_backend_timeout(&NodeUVLoop);
+    if (timeout >= 0 && SteadyNow(1000) + timeout < Deadline)
+    {
+        WakeupPollingThread();
+    }
+}
+
 void FBackendEnv::PollEvents()
 {
 #if PLATFORM_WINDOWS
     DWORD bytes;
-    DWORD timeout = uv_backend_timeout(&NodeUVLoop);
+    // -1转成DWORD即INFINITE
+    DWORD timeout = static_cast<DWORD>(GetPollTimeout());
     ULONG_PTR key;
     OVERLAPPED* overlapped;
 
-    timeout = timeout > 100 ? 100 : timeout;
-
     GetQueuedCompletionStatus(NodeUVLoop.iocp, &bytes, &key, &overlapped, timeout);
 
     // Give the event back so libuv can deal with it.
     if (overlapped != NULL)
         PostQueuedCompletionStatus(NodeUVLoop.iocp, bytes, key, overlapped);
 #elif PLATFORM_LINUX
-    int timeout = uv_backend_timeout(&NodeUVLoop);
-    timeout = (timeout > 100 || timeout < 0) ? 100 : timeout;
+    int timeout = GetPollTimeout();
 
     // Wait for new libuv events.
     int r;
@@ -167,8 +215,7 @@ void FBackendEnv::PollEvents()
     } while (r == -1 && errno == EINTR);
 #elif PLATFORM_MAC
     struct timeval tv;
-    int timeout = uv_backend_timeout(&NodeUVLoop);
-    timeout = (timeout > 100 || timeout < 0) ? 100 : timeout;
+    int timeout = GetPollTimeout();
     if (timeout != -1)
     {
         tv.tv_sec = timeout / 1000;
@@ -218,6 +265,42 @@ void FBackendEnv::StopPolling()
 #endif
 }
 
+void FBackendEnv::SetEventDrivenLoop(bool Enable)
+{
+#if defined(WITH_NODEJS)
+    EventDrivenLoop = Enable;
+    // 让正在等待的轮询线程按新的模式重新计算超时
+    WakeupPollingThread();
+#else
+    (void) Enable;
+#endif
+}
+
+bool FBackendEnv::HasPendingTask() const
+{
+#if defined(WITH_NODEJS)
+    if (hasPendingTask.load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+    if (!EventDrivenLoop)
+    {
+        return false;
+    }
+    // 宿主js新建的定时器比轮询线程当前等待的截止时间更早(例如轮询线程在无限等待)，需要一次LogicTick去唤醒轮询线程，
+    // 否则宿主不调LogicTick，这个定时器永远不会触发
+    int64_t Deadline = PollDeadlineMilliseconds;
+    if (Deadline == 0)
+    {
+        return false;
+    }
+    int timeout = uv_backend_timeout(&NodeUVLoop);
+    return timeout >= 0 && SteadyNow(1000) + timeout < Deadline;
+#else
+    return false;
+#endif
+}
+
 void FBackendEnv::GlobalPrepare()
 {
     if (!GPlatform)
@@ -261,7 +344,8 @@ void FBackendEnv::GlobalPrepare()
     }
 }
 
-void FBackendEnv::Initialize(void* external_quickjs_runtime, void* external_quickjs_context)
+void FBackendEnv::Initialize(void* external_quickjs_runtime, void* external_quickjs_context,
+    const char* SnapshotData, int SnapshotLength, const intptr_t* ExternalReferences, bool PooledArrayBufferAllocator)
 {
 #if defined(WITH_NODEJS)
     const int Ret = uv_loop_init(&NodeUVLoop);
@@ -284,7 +368,38 @@ void FBackendEnv::Initialize(void* external_quickjs_runtime, void* external_quic
 
     // 初始化Isolate和DefaultContext
     CreateParams = new v8::Isolate::CreateParams();
-    CreateParams->array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+#if !WITH_QUICKJS
+    if (PooledArrayBufferAllocator)
+    {
+        PooledAllocator = new FPooledArrayBufferAllocator();
+        CreateParams->array_buffer_allocator = PooledAllocator;
+    }
+    else
+#endif
+    {
+        CreateParams->array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    }
+#if !WITH_QUICKJS
+    if (SnapshotData != nullptr && SnapshotLength > 0)
+    {
+        SnapshotBlob.assign(SnapshotData, SnapshotData + SnapshotLength);
+        SnapshotStartupData.data = SnapshotBlob.data();
+        SnapshotStartupData.raw_size = SnapshotLength;
+#if defined(V8_94_OR_NEWER)
+        // 版本不匹配的snapshot会让v8直接abort，这里先检查，不可用则回退到内置snapshot
+        if (!SnapshotStartupData.IsValid())
+        {
+            PLog(puerts::Warning, "[PuertsDLL][Initialize]snapshot is invalid for current v8, fallback to default");
+            SnapshotBlob.clear();
+        }
+        else
+#endif
+        {
+            CreateParams->snapshot_blob = &SnapshotStartupData;
+            CreateParams->external_references = ExternalReferences;
+        }
+    }
+#endif
     
 #if WITH_QUICKJS
     MainIsolate = (external_quickjs_runtime == nullptr) ? v8::Isolate::New(*CreateParams) : v8::Isolate::New(external_quickjs_runtime);
@@ -371,6 +486,9 @@ void FBackendEnv::Initialize(void* external_quickjs_runtime, void* external_quic
 
 void FBackendEnv::UnInitialize()
 {
+#if defined(WITH_WEBSOCKET)
+    UnInitWebsocketPPWrap(MainIsolate);
+#endif
 #if defined(WITH_QUICKJS)
     JS_FreeValueRT(MainIsolate->runtime_, JsFileNormalize);
     JS_FreeValueRT(MainIsolate->runtime_, JsFileLoader);
@@ -402,6 +520,9 @@ void FBackendEnv::UnInitialize()
 #else
     delete CreateParams->array_buffer_allocator;
     delete CreateParams;
+#if !WITH_QUICKJS
+    PooledAllocator = nullptr;
+#endif
 #endif
 }
 
@@ -418,6 +539,8 @@ void FBackendEnv::LogicTick()
 
     if (hasPendingTask)
         UvRunOnce();
+    else if (EventDrivenLoop)
+        WakeupIfDeadlineMoved();
 #endif
 }
 
@@ -474,11 +597,15 @@ bool FBackendEnv::ClearModuleCache(v8::Isolate* Isolate, v8::Local<v8::Context>
             delete it->second;
         }
         ScriptIdToModuleInfo.clear();
+        ResolvedUrlCache.clear();
 #endif
         return true;
     } 
     else 
     {
+#if !WITH_QUICKJS
+        InvalidateResolvedUrlCache(key);
+#endif
         auto finder = PathToModuleMap.find(key);
         if (finder != PathToModuleMap.end()) 
         {
@@ -706,6 +833,22 @@ char* esmodule::module_normalize(
 }
 
 #else
+
+void FBackendEnv::InvalidateResolvedUrlCache(const std::string& Path)
+{
+    // 被清掉的模块可能重新解析到别的文件，以它为referrer或者解析结果的边都要丢掉
+    for (auto Iter = ResolvedUrlCache.begin(); Iter != ResolvedUrlCache.end();)
+    {
+        if (Iter->second.Referrer == Path || Iter->second.Url == Path)
+        {
+            Iter = ResolvedUrlCache.erase(Iter);
+        }
+        else
+        {
+            ++Iter;
+        }
+    }
+}
     
 v8::MaybeLocal<v8::Value> FBackendEnv::ResolvePath(
     v8::Isolate* Isolate,
@@ -714,10 +857,35 @@ v8::MaybeLocal<v8::Value> FBackendEnv::ResolvePath(
     v8::Local<v8::Value> ReferrerName
 )
 {
+    v8::String::Utf8Value SpecifierUtf8(Isolate, Specifier);
+    v8::String::Utf8Value ReferrerUtf8(Isolate, ReferrerName);
+    std::string Referrer(*ReferrerUtf8, ReferrerUtf8.length());
+    std::string Key = Referrer;
+    Key.push_back('\0');
+    Key.append(*SpecifierUtf8, SpecifierUtf8.length());
+
+    auto Cached = ResolvedUrlCache.find(Key);
+    if (Cached != ResolvedUrlCache.end())
+    {
+        ++ModuleLoadStats.ResolveHits;
+        return v8::MaybeLocal<v8::Value>(FV8Utils::V8String(Isolate, Cached->second.Url.c_str()));
+    }
+    ++ModuleLoadStats.ResolveMisses;
+
     v8::Local<v8::Value> Args[2] = {Specifier, ReferrerName};
 
+    auto Begin = std::chrono::steady_clock::now();
     v8::Local<v8::Function> URLResolveFunction = v8::Local<v8::Function>::Cast(Context->Global()->Get(Context, v8::String::NewFromUtf8(Isolate, "__puer_resolve_module_url__").ToLocalChecked()).ToLocalChecked());
-    return URLResolveFunction->Call(Context, Context->Global(), 2, Args);
+    v8::MaybeLocal<v8::Value> MaybeRet = URLResolveFunction->Call(Context, Context->Global(), 2, Args);
+    ModuleLoadStats.ResolveMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Begin).count();
+
+    v8::Local<v8::Value> Ret;
+    if (MaybeRet.ToLocal(&Ret) && Ret->IsString())
+    {
+        v8::String::Utf8Value Url(Isolate, Ret);
+        ResolvedUrlCache[Key] = FResolvedUrl{Referrer, std::string(*Url, Url.length())};
+    }
+    return MaybeRet;
 }
 
 v8::MaybeLocal<v8::Value> FBackendEnv::ReadFile(
@@ -730,9 +898,12 @@ v8::MaybeLocal<v8::Value> FBackendEnv::ReadFile(
     v8::Local<v8::Array> pathForDebugRef = v8::Array::New(Isolate, 0);
     v8::Local<v8::Value> Args[2] = {URL, pathForDebugRef};
 
+    auto Begin = std::chrono::steady_clock::now();
     v8::Local<v8::Function> ModuleReadFunction = v8::Local<v8::Function>::Cast(Context->Global()->Get(Context, v8::String::NewFromUtf8(Isolate, "__puer_resolve_module_content__").ToLocalChecked()).ToLocalChecked());
 
     v8::MaybeLocal<v8::Value> maybeRet = ModuleReadFunction->Call(Context, Context->Global(), 2, Args);
+    ++ModuleLoadStats.Reads;
+    ModuleLoadStats.ReadMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Begin).count();
 
     v8::Local<v8::Value> pathForDebugValue;
 
@@ -1167,6 +1338,91 @@ std::string FBackendEnv::GetJSStackTrace()
 #endif
 }
 
+v8::MaybeLocal<v8::Script> FBackendEnv::CompileScript(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::String> Source,
+    v8::ScriptOrigin* Origin, const uint8_t* CodeCache, size_t CodeCacheLength, bool* Rejected)
+{
+    if (Rejected)
+    {
+        *Rejected = false;
+    }
+    if (CodeCache == nullptr || CodeCacheLength == 0)
+    {
+        return v8::Script::Compile(Context, Source, Origin);
+    }
+
+#if !defined(WITH_QUICKJS)
+    if (IsCodeCacheUsable(CodeCache, CodeCacheLength, static_cast<size_t>(Source->Length())))
+    {
+        // 运行时的v8 flags(比如--expose-gc)和v8cc生成时可能不一致，和ue那边一样把FlagHash修正成当前值，其他校验交给v8
+        uint32_t ExpectFlagHash = GetExpectCodeCacheFlagHash(Isolate, Context);
+        const FCodeCacheHeader* Header = reinterpret_cast<const FCodeCacheHeader*>(CodeCache);
+        std::vector<uint8_t> Patched;
+        if (Header->FlagHash != ExpectFlagHash)
+        {
+            Patched.assign(CodeCache, CodeCache + CodeCacheLength);
+            reinterpret_cast<FCodeCacheHeader*>(Patched.data())->FlagHash = ExpectFlagHash;
+            CodeCache = Patched.data();
+        }
+
+        // BufferNotOwned，CachedData由Source析构时释放，数据由调用者持有
+        v8::ScriptCompiler::Source ScriptSource(Source, *Origin,
+            new v8::ScriptCompiler::CachedData(CodeCache, static_cast<int>(CodeCacheLength)));
+        // 被拒绝时v8内部会直接按源码完整编译，不需要再编译一次
+        auto Script = v8::ScriptCompiler::Compile(Context, &ScriptSource, v8::ScriptCompiler::kConsumeCodeCache);
+        if (ScriptSource.GetCachedData()->rejected)
+        {
+            ++CodeCacheStats.Rejected;
+            if (Rejected)
+            {
+                *Rejected = true;
+            }
+        }
+        else
+        {
+            ++CodeCacheStats.Accepted;
+        }
+        return Script;
+    }
+#endif
+    ++CodeCacheStats.Rejected;
+    if (Rejected)
+    {
+        *Rejected = true;
+    }
+    return v8::Script::Compile(Context, Source, Origin);
+}
+
+bool FBackendEnv::CreateCodeCache(v8::Local<v8::Script> Script, std::vector<uint8_t>& OutData)
+{
+#if !defined(WITH_QUICKJS)
+    v8::ScriptCompiler::CachedData* CachedData = v8::ScriptCompiler::CreateCodeCache(Script->GetUnboundScript());
+    if (!CachedData)
+    {
+        return false;
+    }
+    OutData.assign(CachedData->data, CachedData->data + CachedData->length);
+    delete CachedData;
+    ++CodeCacheStats.Produced;
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if !defined(WITH_QUICKJS)
+uint32_t FBackendEnv::GetExpectCodeCacheFlagHash(v8::Isolate* Isolate, v8::Local<v8::Context> Context)
+{
+    if (!ExpectCodeCacheFlagHash)
+    {
+        auto Script = v8::Script::Compile(Context, v8::String::Empty(Isolate)).ToLocalChecked();
+        v8::ScriptCompiler::CachedData* CachedData = v8::ScriptCompiler::CreateCodeCache(Script->GetUnboundScript());
+        ExpectCodeCacheFlagHash = reinterpret_cast<const FCodeCacheHeader*>(CachedData->data)->FlagHash;
+        delete CachedData;
+    }
+    return ExpectCodeCacheFlagHash;
+}
+#endif
+
 #if !defined(WITH_QUICKJS)
 
 #define SetNumericStatProperty(name)                                           \
@@ -1226,6 +1482,51 @@ void GetHeapSpaceStatistics(const v8::FunctionCallbackInfo<v8::Value>& info)
 
 #undef SetUIntStatProperty
 
+void GetModuleLoadStatistics(const v8::FunctionCallbackInfo<v8::Value>& info)
+{
+    v8::Isolate* isolate = info.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    FBackendEnv* backendEnv = FBackendEnv::Get(isolate);
+    // 生成snapshot时没有FBackendEnv
+    if (backendEnv == nullptr)
+    {
+        return;
+    }
+    v8::Local<v8::Object> target = v8::Object::New(isolate);
+    const FBackendEnv::FModuleLoadStats& stat = backendEnv->ModuleLoadStats;
+
+    target->Set(context, v8::String::NewFromUtf8(isolate, "resolve_hits").ToLocalChecked(), v8::Number::New(isolate, stat.ResolveHits)).Check();
+    target->Set(context, v8::String::NewFromUtf8(isolate, "resolve_misses").ToLocalChecked(), v8::Number::New(isolate, stat.ResolveMisses)).Check();
+    target->Set(context, v8::String::NewFromUtf8(isolate, "resolve_ms").ToLocalChecked(), v8::Number::New(isolate, stat.ResolveMilliseconds)).Check();
+    target->Set(context, v8::String::NewFromUtf8(isolate, "reads").ToLocalChecked(), v8::Number::New(isolate, stat.Reads)).Check();
+    target->Set(context, v8::String::NewFromUtf8(isolate, "read_ms").ToLocalChecked(), v8::Number::New(isolate, stat.ReadMilliseconds)).Check();
+
+    info.GetReturnValue().Set(target);
+}
+
+void GetArrayBufferAllocatorStatistics(const v8::FunctionCallbackInfo<v8::Value>& info)
+{
+    v8::Isolate* isolate = info.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    FBackendEnv* backendEnv = FBackendEnv::Get(isolate);
+    // 没有启用池化分配器时返回undefined
+    if (backendEnv == nullptr || backendEnv->PooledAllocator == nullptr)
+    {
+        return;
+    }
+    v8::Local<v8::Object> target = v8::Object::New(isolate);
+    const FArrayBufferAllocatorStats stat = backendEnv->PooledAllocator->GetStats();
+
+    target->Set(context, v8::String::NewFromUtf8(isolate, "allocated_bytes").ToLocalChecked(), v8::Number::New(isolate, static_cast<double>(stat.AllocatedBytes))).Check();
+    target->Set(context, v8::String::NewFromUtf8(isolate, "pooled_bytes").ToLocalChecked(), v8::Number::New(isolate, static_cast<double>(stat.PooledBytes))).Check();
+    target->Set(context, v8::String::NewFromUtf8(isolate, "peak_bytes").ToLocalChecked(), v8::Number::New(isolate, static_cast<double>(stat.PeakBytes))).Check();
+    target->Set(context, v8::String::NewFromUtf8(isolate, "large_bytes").ToLocalChecked(), v8::Number::New(isolate, static_cast<double>(stat.LargeBytes))).Check();
+    target->Set(context, v8::String::NewFromUtf8(isolate, "allocations").ToLocalChecked(), v8::Number::New(isolate, static_cast<double>(stat.Allocations))).Check();
+    target->Set(context, v8::String::NewFromUtf8(isolate, "pool_hits").ToLocalChecked(), v8::Number::New(isolate, static_cast<double>(stat.PoolHits))).Check();
+
+    info.GetReturnValue().Set(target);
+}
+
 v8::Local<v8::Object> FBackendEnv::GetV8Extras(v8::Isolate* isolate, v8::Local<v8::Context> context)
 {
     v8::Local<v8::Object> ret = v8::Object::New(isolate);
@@ -1233,7 +1534,21 @@ v8::Local<v8::Object> FBackendEnv::GetV8Extras(v8::Isolate* isolate, v8::Local<v
         v8::Function::New(context, GetHeapStatistics).ToLocalChecked()).Check();
     ret->Set(context, v8::String::NewFromUtf8(isolate, "getHeapSpaceStatistics").ToLocalChecked(), 
         v8::Function::New(context, GetHeapSpaceStatistics).ToLocalChecked()).Check();
+    ret->Set(context, v8::String::NewFromUtf8(isolate, "getModuleLoadStatistics").ToLocalChecked(), 
+        v8::Function::New(context, GetModuleLoadStatistics).ToLocalChecked()).Check();
+    ret->Set(context, v8::String::NewFromUtf8(isolate, "getArrayBufferAllocatorStatistics").ToLocalChecked(), 
+        v8::Function::New(context, GetArrayBufferAllocatorStatistics).ToLocalChecked()).Check();
     return ret;
 }
+
+void FBackendEnv::AppendExternalReferences(std::vector<intptr_t>& References)
+{
+    References.push_back(reinterpret_cast<intptr_t>(&SetPromiseRejectCallback<FBackendEnv>));
+    References.push_back(reinterpret_cast<intptr_t>(&esmodule::ExecuteModule));
+    References.push_back(reinterpret_cast<intptr_t>(&GetHeapStatistics));
+    References.push_back(reinterpret_cast<intptr_t>(&GetHeapSpaceStatistics));
+    References.push_back(reinterpret_cast<intptr_t>(&GetModuleLoadStatistics));
+    References.push_back(reinterpret_cast<intptr_t>(&GetArrayBufferAllocatorStatistics));
+}
 #endif
 }
@@ -41,6 +41,80 @@ namespace PUERTS_NAMESPACE
         return Ab;
     }
 
+    struct FExternalBufferReleaser
+    {
+        CSharpExternalBufferRelease Release;
+        int64_t UserData;
+    };
+
+    static void ExternalBufferDeleter(void* Data, size_t /*Length*/, void* DeleterData)
+    {
+        FExternalBufferReleaser* Releaser = static_cast<FExternalBufferReleaser*>(DeleterData);
+        Releaser->Release(Data, Releaser->UserData);
+        delete Releaser;
+    }
+
+    v8::Local<v8::ArrayBuffer> NewExternalArrayBuffer(v8::Isolate* Isolate, void *Ptr, size_t Size, CSharpExternalBufferRelease Release, int64_t UserData)
+    {
+        std::unique_ptr<v8::BackingStore> Backing = Release
+            ? v8::ArrayBuffer::NewBackingStore(Ptr, Size, ExternalBufferDeleter, new FExternalBufferReleaser{Release, UserData})
+            : v8::ArrayBuffer::NewBackingStore(Ptr, Size, v8::BackingStore::EmptyDeleter, nullptr);
+        return v8::ArrayBuffer::New(Isolate, std::move(Backing));
+    }
+
+    void* AcquireArrayBuffer(v8::Value *Value, void** Data, int *Length)
+    {
+        std::shared_ptr<v8::BackingStore> Backing;
+        size_t Offset = 0;
+        size_t ByteLength = 0;
+        if (Value->IsArrayBufferView())
+        {
+            v8::ArrayBufferView * BuffView = v8::ArrayBufferView::Cast(Value);
+            Backing = BuffView->Buffer()->GetBackingStore();
+            Offset = BuffView->ByteOffset();
+            ByteLength = BuffView->ByteLength();
+        }
+        else if (Value->IsArrayBuffer())
+        {
+            Backing = v8::ArrayBuffer::Cast(Value)->GetBackingStore();
+            ByteLength = Backing->ByteLength();
+        }
+        else
+        {
+            return nullptr;
+        }
+        *Data = static_cast<char*>(Backing->Data()) + Offset;
+        *Length = static_cast<int>(ByteLength);
+        return new std::shared_ptr<v8::BackingStore>(std::move(Backing));
+    }
+
+    void ReleaseArrayBuffer(void* Handle)
+    {
+        delete static_cast<std::shared_ptr<v8::BackingStore>*>(Handle);
+    }
+
+    const uint16_t* ToUtf16(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Value *Value, std::vector<uint16_t>& Buffer, int *Length)
+    {
+        *Length = 0;
+        v8::Local<v8::String> Str;
+        if (Value->IsNullOrUndefined() || !Value->ToString(Context).ToLocal(&Str))
+        {
+            return nullptr;
+        }
+#if defined(WITH_QUICKJS)
+        v8::String::Utf8Value Utf8(Isolate, Str);
+        FV8Utils::Utf8ToUtf16(*Utf8, Utf8.length(), Buffer);
+        *Length = static_cast<int>(Buffer.size());
+        // 空字符串也要返回非空指针，和null区分
+        Buffer.push_back(0);
+#else
+        *Length = Str->Length();
+        Buffer.resize(*Length + 1);
+        Str->Write(Isolate, Buffer.data(), 0, *Length, v8::String::NO_NULL_TERMINATION);
+#endif
+        return Buffer.data();
+    }
+
     static void EvalWithPath(const v8::FunctionCallbackInfo<v8::Value>& Info)
     {
         v8::Isolate* Isolate = Info.GetIsolate();
@@ -91,16 +165,103 @@ namespace PUERTS_NAMESPACE
         LastExceptionInfo = FV8Utils::ExceptionToString(MainIsolate, Exception);
     }
 
+#if !WITH_QUICKJS
+    const intptr_t* JSEngine::GetExternalReferences()
+    {
+        static const std::vector<intptr_t> References = []()
+        {
+            std::vector<intptr_t> Ret;
+            FBackendEnv::AppendExternalReferences(Ret);
+            Ret.push_back(reinterpret_cast<intptr_t>(&EvalWithPath));
+            Ret.push_back(reinterpret_cast<intptr_t>(&GetLastException));
+            Ret.push_back(reinterpret_cast<intptr_t>(&JSObjectValueGetterFunction));
+            Ret.push_back(0);
+            return Ret;
+        }();
+        return References.data();
+    }
+#endif
+
+    bool JSEngine::CreateSnapshot(const char* BootstrapScript, const char* Path, std::vector<char>& OutBlob, std::string& OutError)
+    {
+        OutBlob.clear();
+        OutError.clear();
+#if defined(WITH_QUICKJS) || defined(WITH_NODEJS)
+        OutError = "snapshot is not supported by current backend";
+        return false;
+#else
+        FBackendEnv::GlobalPrepare();
+
+        v8::StartupData Blob;
+        {
+            v8::SnapshotCreator Creator(GetExternalReferences());
+            v8::Isolate* Isolate = Creator.GetIsolate();
+#ifdef THREAD_SAFE
+            v8::Locker Locker(Isolate);
+#endif
+            {
+                v8::HandleScope HandleScope(Isolate);
+                v8::Local<v8::Context> Context = v8::Context::New(Isolate);
+                v8::Context::Scope ContextScope(Context);
+                v8::Local<v8::Object> Global = Context->Global();
+                Global->Set(Context, FV8Utils::V8String(Isolate, "__tgjsEvalScript"), v8::FunctionTemplate::New(Isolate, &EvalWithPath)->GetFunction(Context).ToLocalChecked()).Check();
+                Global->Set(Context, FV8Utils::V8String(Isolate, "v8"), FBackendEnv::GetV8Extras(Isolate, Context)).Check();
+
+                v8::Local<v8::String> Url = FV8Utils::V8String(Isolate, Path == nullptr ? "" : Path);
+                v8::Local<v8::String> Source = FV8Utils::V8String(Isolate, BootstrapScript);
+#if defined(V8_94_OR_NEWER)
+                v8::ScriptOrigin Origin(Isolate, Url);
+#else
+                v8::ScriptOrigin Origin(Url);
+#endif
+                v8::TryCatch TryCatch(Isolate);
+                v8::Local<v8::Script> CompiledScript;
+                v8::Local<v8::Value> Result;
+                // bootstrap抛异常时context只初始化了一半，不能生成快照
+                if (!v8::Script::Compile(Context, Source, &Origin).ToLocal(&CompiledScript) || !CompiledScript->Run(Context).ToLocal(&Result))
+                {
+                    OutError = TryCatch.HasCaught() ? FV8Utils::ExceptionToString(Isolate, TryCatch.Exception()) : "run bootstrap script failed";
+                }
+                // 即使出错也要设置DefaultContext并CreateBlob，否则SnapshotCreator析构时会断言失败
+                Creator.SetDefaultContext(Context);
+            }
+            // 保留已编译的函数，加载时省掉bootstrap代码的lazy compile
+            Blob = Creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kKeep);
+        }
+
+        if (Blob.data == nullptr || Blob.raw_size <= 0)
+        {
+            if (OutError.empty())
+            {
+                OutError = "create snapshot blob failed";
+            }
+        }
+        else if (OutError.empty())
+        {
+            OutBlob.assign(Blob.data, Blob.data + Blob.raw_size);
+        }
+        delete[] Blob.data;
+        return OutError.empty();
+#endif
+    }
+
 #ifdef MULT_BACKENDS
-    JSEngine::JSEngine(puerts::IPuertsPlugin* InPuertsPlugin, void* external_quickjs_runtime, void* external_quickjs_context)
+    JSEngine::JSEngine(puerts::IPuertsPlugin* InPuertsPlugin, void* external_quickjs_runtime, void* external_quickjs_context,
+        const char* SnapshotData, int SnapshotLength, bool PooledArrayBufferAllocator)
 #else
-    JSEngine::JSEngine(void* external_quickjs_runtime, void* external_quickjs_context)
+    JSEngine::JSEngine(void* external_quickjs_runtime, void* external_quickjs_context,
+        const char* SnapshotData, int SnapshotLength, bool PooledArrayBufferAllocator)
 #endif
     {
         GeneralDestructor = nullptr;
         FBackendEnv::GlobalPrepare();
 
+#if WITH_QUICKJS
         BackendEnv.Initialize(external_quickjs_runtime, external_quickjs_context);
+#else
+        BackendEnv.Initialize(external_quickjs_runtime, external_quickjs_context, SnapshotData, SnapshotLength,
+            SnapshotData != nullptr ? GetExternalReferences() : nullptr, PooledArrayBufferAllocator);
+#endif
         MainIsolate = BackendEnv.MainIsolate;
 
         auto Isolate = MainIsolate;
@@ -127,6 +288,7 @@ namespace PUERTS_NAMESPACE
         }
         Global->Set(Context, FV8Utils::V8String(Isolate, "__tgjsEvalScript"), v8::FunctionTemplate::New(Isolate, &EvalWithPath)->GetFunction(Context).ToLocalChecked()).Check();
 
+        JSFunctionIdMap.Reset(Isolate, v8::Map::New(Isolate));
         JSObjectIdMap.Reset(Isolate, v8::Map::New(Isolate));
 
         JSObjectValueGetter = CreateJSFunction(
@@ -143,6 +305,7 @@ namespace PUERTS_NAMESPACE
         BackendEnv.StopPolling();
         DestroyInspector();
 
+        JSFunctionIdMap.Reset();
         JSObjectIdMap.Reset();
         BackendEnv.JsPromiseRejectCallback.Reset();
         LastException.Reset();
@@ -176,7 +339,7 @@ namespace PUERTS_NAMESPACE
                     if (LifeCycleInfo && LifeCycleInfo->Size > 0)
                     {
                         auto Ptr = FV8Utils::GetPoninter(Object);
-                        free(Ptr);
+                        SlabAllocator.Free(Ptr, LifeCycleInfo->Size);
                     }
                 }
                 Iter->second.Reset();
@@ -186,17 +349,11 @@ namespace PUERTS_NAMESPACE
         }
         {
             std::lock_guard<std::mutex> guard(JSFunctionsMutex);
-            for (auto Iter = JSFunctions.begin(); Iter != JSFunctions.end(); ++Iter)
-            {
-                delete *Iter;
-            }
+            JSFunctions.ForEach([](JSFunction* Function) { delete Function; });
         }
         {
             std::lock_guard<std::mutex> guard(JSObjectsMutex);
-            for (auto Iter = JSObjectMap.begin(); Iter != JSObjectMap.end(); ++Iter)
-            {
-                delete Iter->second;
-            }
+            JSObjects.ForEach([](JSObject* Object) { delete Object; });
         }
 
         ResultInfo.Context.Reset();
@@ -206,12 +363,12 @@ namespace PUERTS_NAMESPACE
 
         for (int i = 0; i < CallbackInfos.size(); ++i)
         {
-            delete CallbackInfos[i];
+            SlabAllocator.Delete(CallbackInfos[i]);
         }
 
         for (int i = 0; i < LifeCycleInfos.size(); ++i)
         {
-            delete LifeCycleInfos[i];
+            SlabAllocator.Delete(LifeCycleInfos[i]);
         }
     }
 
@@ -244,6 +401,11 @@ namespace PUERTS_NAMESPACE
     }
 
     bool JSEngine::Eval(const char *Code, const char* Path)
+    {
+        return EvalWithCodeCache(Code, Path, nullptr, 0, nullptr);
+    }
+
+    bool JSEngine::EvalWithCodeCache(const char *Code, const char* Path, const uint8_t* CodeCache, int CodeCacheLength, bool* CodeCacheRejected)
     {
         v8::Isolate* Isolate = MainIsolate;
 #ifdef THREAD_SAFE
@@ -263,7 +425,8 @@ namespace PUERTS_NAMESPACE
 #endif
         v8::TryCatch TryCatch(Isolate);
 
-        auto CompiledScript = v8::Script::Compile(Context, Source, &Origin);
+        auto CompiledScript = BackendEnv.CompileScript(Isolate, Context, Source, &Origin, CodeCache,
+            CodeCacheLength > 0 ? static_cast<size_t>(CodeCacheLength) : 0, CodeCacheRejected);
         if (CompiledScript.IsEmpty())
         {
             SetLastException(TryCatch.Exception());
@@ -284,6 +447,71 @@ namespace PUERTS_NAMESPACE
         return true;
     }
 
+    bool JSEngine::CreateCodeCache(const char *Code, const char* Path)
+    {
+        v8::Isolate* Isolate = MainIsolate;
+#ifdef THREAD_SAFE
+        v8::Locker Locker(Isolate);
+#endif
+        v8::Isolate::Scope IsolateScope(Isolate);
+        v8::HandleScope HandleScope(Isolate);
+        v8::Local<v8::Context> Context = ResultInfo.Context.Get(Isolate);
+        v8::Context::Scope ContextScope(Context);
+
+        v8::Local<v8::String> Url = FV8Utils::V8String(Isolate, Path == nullptr ? "" : Path);
+        v8::Local<v8::String> Source = FV8Utils::V8String(Isolate, Code);
+#if defined(V8_94_OR_NEWER) && !defined(WITH_QUICKJS)
+        v8::ScriptOrigin Origin(Isolate, Url);
+#else
+        v8::ScriptOrigin Origin(Url);
+#endif
+        v8::TryCatch TryCatch(Isolate);
+
+        CodeCacheBuffer.clear();
+        auto CompiledScript = v8::Script::Compile(Context, Source, &Origin);
+        if (CompiledScript.IsEmpty())
+        {
+            SetLastException(TryCatch.Exception());
+            return false;
+        }
+        if (!BackendEnv.CreateCodeCache(CompiledScript.ToLocalChecked(), CodeCacheBuffer))
+        {
+            LastExceptionInfo = "code cache is not supported by current backend";
+            return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    T* JSEngine::FindByIdMap(THandleTable<T>& Table, v8::Local<v8::Map> IdMap, v8::Local<v8::Context> Context, v8::Local<v8::Value> Key)
+    {
+        v8::Local<v8::Value> Handle = IdMap->Get(Context, Key).ToLocalChecked();
+        if (!Handle->IsNumber())
+        {
+            return nullptr;
+        }
+        return Table.Find(static_cast<int64_t>(v8::Number::Cast(*Handle)->Value()));
+    }
+
+    bool JSEngine::GetHandleTableStats(int Kind, FHandleTableStats* OutStats, int* OutLive)
+    {
+        if (Kind == 0)
+        {
+            std::lock_guard<std::mutex> guard(JSFunctionsMutex);
+            *OutStats = JSFunctions.GetStats();
+            *OutLive = JSFunctions.LiveCount();
+            return true;
+        }
+        else if (Kind == 1)
+        {
+            std::lock_guard<std::mutex> guard(JSObjectsMutex);
+            *OutStats = JSObjects.GetStats();
+            *OutLive = JSObjects.LiveCount();
+            return true;
+        }
+        return false;
+    }
+
     JSObject *JSEngine::CreateJSObject(v8::Isolate *InIsolate, v8::Local<v8::Context> InContext, v8::Local<v8::Object> InObject)
     {
         // PLog(puerts::Log, "[PuertsDLL][CreateJSObject]mutex");
@@ -301,38 +529,16 @@ namespace PUERTS_NAMESPACE
         v8::Local<v8::Map> idmap = JSObjectIdMap.Get(InIsolate);
         
         // PLog(puerts::Log, "[PuertsDLL][CreateJSObject]get v8object id");
-        // 从idmap尝试取出该jsObject的id
-        v8::Local<v8::Value> v8ObjectIndex = idmap->Get(InContext, InObject).ToLocalChecked();
-        JSObject* jsObject = nullptr;
-
-        // PLog(puerts::Log, "[PuertsDLL][CreateJSObject]get jsobject");
-        // 如果存在该id，则从objectmap里取出该对象
-        if (!v8ObjectIndex->IsNullOrUndefined())
-        {
-            int32_t mapIndex = (int32_t)v8::Number::Cast(*v8ObjectIndex)->Value();
-            auto iter = JSObjectMap.find(mapIndex);
-            if (iter != JSObjectMap.end())
-            {
-                jsObject = iter->second;
-            }
-        }
+        // 从idmap尝试取出该jsObject的id，如果存在该id，则从handle表里取出该对象
+        JSObject* jsObject = FindByIdMap(JSObjects, idmap, InContext, InObject);
 
         // 如果不存在id，则创建新对象
         if (jsObject == nullptr) 
         {
-            int32_t id = 0;
-            size_t freeIDSize = ObjectMapFreeIndex.size();
-            if (freeIDSize > 0) {
-                id = ObjectMapFreeIndex[freeIDSize - 1];
-                ObjectMapFreeIndex.pop_back();
-            }
-            else
-            {
-                id = JSObjectMap.size();
-            }
+            int32_t id = JSObjects.Allocate();
             jsObject = new JSObject(InIsolate, InContext, InObject, id);
-            JSObjectMap[id] = jsObject;
-            idmap->Set(InContext, InObject, v8::Number::New(InIsolate, id));
+            JSObjects.Assign(id, jsObject);
+            idmap->Set(InContext, InObject, v8::Number::New(InIsolate, static_cast<double>(JSObjects.ToHandle(id))));
         }
 
         return jsObject;
@@ -352,52 +558,50 @@ namespace PUERTS_NAMESPACE
         v8::Local<v8::Context> Context = InObject->Context.Get(Isolate);
         v8::Context::Scope ContextScope(Context);
 
-        v8::Local<v8::Map> idmap = JSObjectIdMap.Get(InObject->Isolate);
-        idmap->Delete(InObject->Context.Get(Isolate), InObject->GObject.Get(Isolate));
-        JSObjectMap.erase(InObject->Index);
-
-        ObjectMapFreeIndex.push_back(InObject->Index);
+        v8::Local<v8::Map> idmap = JSObjectIdMap.Get(Isolate);
+        idmap->Delete(Context, InObject->GObject.Get(Isolate));
+        JSObjects.Free(InObject->Index);
         delete InObject;
     }
 
     JSFunction* JSEngine::CreateJSFunction(v8::Isolate* InIsolate, v8::Local<v8::Context> InContext, v8::Local<v8::Function> InFunction)
     {
         std::lock_guard<std::mutex> guard(JSFunctionsMutex);
-        auto maybeId = InFunction->Get(InContext, FV8Utils::V8String(InIsolate, FUNCTION_INDEX_KEY));
-        if (!maybeId.IsEmpty()) {
-            auto id = maybeId.ToLocalChecked();
-            if (id->IsNumber()) {
-                int32_t index = id->Int32Value(InContext).ToChecked();
-                return JSFunctions[index];
-            }
-        }
-        JSFunction* Function = nullptr;
-        for (int i = 0; i < JSFunctions.size(); i++) {
-            if (!JSFunctions[i]) {
-#ifdef MULT_BACKENDS
-                Function = new JSFunction(ResultInfo.PuertsPlugin, InIsolate, InContext, InFunction, i);
-#else
-                Function = new JSFunction(InIsolate, InContext, InFunction, i);
-#endif
-                JSFunctions[i] = Function;
-                break;
-            }
+        v8::Local<v8::Map> idmap = JSFunctionIdMap.Get(InIsolate);
+        JSFunction* Function = FindByIdMap(JSFunctions, idmap, InContext, InFunction);
+        if (Function)
+        {
+            return Function;
         }
-        if (!Function) {
+
+        int32_t id = JSFunctions.Allocate();
 #ifdef MULT_BACKENDS
-            Function = new JSFunction(ResultInfo.PuertsPlugin, InIsolate, InContext, InFunction, static_cast<int32_t>(JSFunctions.size()));
+        Function = new JSFunction(ResultInfo.PuertsPlugin, InIsolate, InContext, InFunction, id);
 #else
-            Function = new JSFunction(InIsolate, InContext, InFunction, static_cast<int32_t>(JSFunctions.size()));
+        Function = new JSFunction(InIsolate, InContext, InFunction, id);
 #endif
-            JSFunctions.push_back(Function);
-        }
-        InFunction->Set(InContext, FV8Utils::V8String(InIsolate, FUNCTION_INDEX_KEY), v8::Integer::New(InIsolate, Function->Index));
+        JSFunctions.Assign(id, Function);
+        idmap->Set(InContext, InFunction, v8::Number::New(InIsolate, static_cast<double>(JSFunctions.ToHandle(id))));
         return Function;
     }
 
     void JSEngine::ReleaseJSFunction(JSFunction* InFunction)
     {
-        JSFunctions[InFunction->Index] = nullptr;
+        v8::Isolate* Isolate = InFunction->ResultInfo.Isolate;
+#ifdef THREAD_SAFE
+        v8::Locker Locker(Isolate);
+#endif
+        // 先Locker再加锁，和在js回调里(已持有isolate锁)调用的CreateJSFunction保持同样的加锁顺序
+        std::lock_guard<std::mutex> guard(JSFunctionsMutex);
+
+        v8::Isolate::Scope IsolateScope(Isolate);
+        v8::HandleScope HandleScope(Isolate);
+        v8::Local<v8::Context> Context = InFunction->ResultInfo.Context.Get(Isolate);
+        v8::Context::Scope ContextScope(Context);
+
+        v8::Local<v8::Map> idmap = JSFunctionIdMap.Get(Isolate);
+        idmap->Delete(Context, InFunction->GFunction.Get(Isolate));
+        JSFunctions.Free(InFunction->Index);
         delete InFunction;
     }
 
@@ -421,7 +625,7 @@ namespace PUERTS_NAMESPACE
     v8::Local<v8::FunctionTemplate> JSEngine::ToTemplate(v8::Isolate* Isolate, bool IsStatic, CSharpFunctionCallback Callback, int64_t Data)
     {
         auto Pos = CallbackInfos.size();
-        auto CallbackInfo = new FCallbackInfo(IsStatic, Callback, Data);
+        auto CallbackInfo = SlabAllocator.New<FCallbackInfo>(IsStatic, Callback, Data);
         CallbackInfos.push_back(CallbackInfo);
 #if defined(WITH_QUICKJS)
         return v8::FunctionTemplate::New(Isolate, CSharpFunctionCallbackWrap, v8::External::New(Isolate, CallbackInfos[Pos]));
@@ -509,7 +713,7 @@ namespace PUERTS_NAMESPACE
         int ClassId = static_cast<int>(Templates.size());
 
         auto Pos = LifeCycleInfos.size();
-        auto LifeCycleInfo = new FLifeCycleInfo(ClassId, Constructor, Destructor ? Destructor : GeneralDestructor, Data, Size);
+        auto LifeCycleInfo = SlabAllocator.New<FLifeCycleInfo>(ClassId, Constructor, Destructor ? Destructor : GeneralDestructor, Data, Size);
         LifeCycleInfos.push_back(LifeCycleInfo);
         
         auto Template = v8::FunctionTemplate::New(Isolate, NewWrap, v8::External::New(Isolate, LifeCycleInfos[Pos]));
@@ -640,7 +844,7 @@ namespace PUERTS_NAMESPACE
     {
         if (LifeCycleInfo->Size > 0)
         {
-            void *Val = malloc(LifeCycleInfo->Size);
+            void *Val = SlabAllocator.Allocate(LifeCycleInfo->Size);
             if (Ptr != nullptr)
             {
                 memcpy(Val, Ptr, LifeCycleInfo->Size);
@@ -667,7 +871,7 @@ namespace PUERTS_NAMESPACE
 
         if (LifeCycleInfo->Size > 0)
         {
-            free(Ptr);
+            SlabAllocator.Free(Ptr, LifeCycleInfo->Size);
         }
         else
         {
@@ -50,10 +50,6 @@ namespace PUERTS_NAMESPACE
         v8::Local<v8::Context> Context = ResultInfo.Context.Get(Isolate);
         v8::Context::Scope ContextScope(Context);
 
-        auto Function = GFunction.Get(Isolate);
-
-        Function->Set(Context, FV8Utils::V8String(Isolate, FUNCTION_INDEX_KEY), v8::Undefined(Isolate));
-
         GFunction.Reset();
         ResultInfo.Result.Reset();
         ResultInfo.Context.Reset();
@@ -72,7 +68,8 @@ namespace PUERTS_NAMESPACE
         case puerts::Date:
             return v8::Date::New(Context, Value.Number).ToLocalChecked();
         case puerts::String:
-            return FV8Utils::V8String(Isolate, Value.Str.c_str());
+            // UTF-16/单字节版本的Push在入参时已经创建好了v8字符串
+            return Value.Persistent.IsEmpty() ? v8::Local<v8::Value>(FV8Utils::V8String(Isolate, Value.Str.c_str())) : Value.Persistent.Get(Isolate);
         case puerts::NativeObject:
             return Value.Persistent.Get(Isolate);
         case puerts::Function:
@@ -88,6 +85,107 @@ namespace PUERTS_NAMESPACE
         }
     }
 
+    static v8::Local<v8::Value> ToV8(v8::Isolate* Isolate, v8::Local<v8::Context> Context, const puerts::FBatchValue &Value, const char* Data)
+    {
+        switch (Value.Type)
+        {
+        case puerts::NullOrUndefined:
+            return v8::Null(Isolate);
+        case puerts::BigInt:
+            return v8::BigInt::New(Isolate, Value.BigInt);
+        case puerts::Number:
+            return v8::Number::New(Isolate, Value.Number);
+        case puerts::Date:
+            return v8::Date::New(Context, Value.Number).ToLocalChecked();
+        case puerts::String:
+            return v8::String::NewFromUtf8(Isolate, Data + Value.Offset, v8::NewStringType::kNormal, Value.Length).ToLocalChecked();
+        case puerts::NativeObject:
+            return FV8Utils::IsolateData<JSEngine>(Isolate)->FindOrAddObject(Isolate, Context, Value.Length, Value.Ptr);
+        case puerts::Function:
+            return static_cast<JSFunction*>(Value.Ptr)->GFunction.Get(Isolate);
+        case puerts::JsObject:
+            return static_cast<JSObject*>(Value.Ptr)->GObject.Get(Isolate);
+        case puerts::Boolean:
+            return v8::Boolean::New(Isolate, Value.Boolean != 0);
+        case puerts::ArrayBuffer:
+            return NewArrayBuffer(Isolate, const_cast<char*>(Data + Value.Offset), Value.Length);
+        default:
+            return v8::Undefined(Isolate);
+        }
+    }
+
+    static void ToBatchValue(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Value> Value, puerts::FBatchValue* Slot, char* Data, int DataCapacity)
+    {
+        Slot->Type = FV8Utils::GetType(Context, *Value);
+        Slot->Length = 0;
+        Slot->BigInt = 0;
+        switch (Slot->Type)
+        {
+        case puerts::BigInt:
+            Slot->BigInt = Value->ToBigInt(Context).ToLocalChecked()->Int64Value();
+            break;
+        case puerts::Number:
+            Slot->Number = Value->NumberValue(Context).ToChecked();
+            break;
+        case puerts::Date:
+            Slot->Number = v8::Date::Cast(*Value)->ValueOf();
+            break;
+        case puerts::Boolean:
+            Slot->Boolean = Value->BooleanValue(Isolate) ? 1 : 0;
+            break;
+        case puerts::String:
+        {
+            v8::Local<v8::String> Str;
+            if (!Value->ToString(Context).ToLocal(&Str))
+            {
+                Slot->Type = puerts::NullOrUndefined;
+                break;
+            }
+            Slot->Length = Str->Utf8Length(Isolate);
+            // 放不下时Offset为-1，调用方回退到GetStringFromResult
+            if (Data && Slot->Length <= DataCapacity)
+            {
+                Str->WriteUtf8(Isolate, Data, DataCapacity, nullptr, v8::String::NO_NULL_TERMINATION);
+                Slot->Offset = 0;
+            }
+            else
+            {
+                Slot->Offset = -1;
+            }
+            break;
+        }
+        case puerts::NativeObject:
+        {
+            Slot->Ptr = FV8Utils::GetPoninter(Context, Value);
+            auto LifeCycleInfo = static_cast<FLifeCycleInfo *>(FV8Utils::GetPoninter(Context, Value, 1));
+            Slot->Length = LifeCycleInfo ? LifeCycleInfo->ClassID : -1;
+            break;
+        }
+        case puerts::Function:
+            Slot->Ptr = FV8Utils::IsolateData<JSEngine>(Isolate)->CreateJSFunction(Isolate, Context, Value.As<v8::Function>());
+            break;
+        case puerts::JsObject:
+            Slot->Ptr = FV8Utils::IsolateData<JSEngine>(Isolate)->CreateJSObject(Isolate, Context, Value.As<v8::Object>());
+            break;
+        case puerts::ArrayBuffer:
+            if (Value->IsArrayBufferView())
+            {
+                v8::Local<v8::ArrayBufferView> BuffView = Value.As<v8::ArrayBufferView>();
+                Slot->Length = static_cast<int32_t>(BuffView->ByteLength());
+                Slot->Ptr = static_cast<char*>(BuffView->Buffer()->GetBackingStore()->Data()) + BuffView->ByteOffset();
+            }
+            else
+            {
+                auto ABS = Value.As<v8::ArrayBuffer>()->GetBackingStore();
+                Slot->Length = static_cast<int32_t>(ABS->ByteLength());
+                Slot->Ptr = ABS->Data();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
     /*void JSFunction::SetResult(v8::MaybeLocal<v8::Value> maybeValue)
     {
 
@@ -132,4 +230,61 @@ namespace PUERTS_NAMESPACE
             return true;
         }
     }
+
+    bool JSFunction::InvokeBatched(const puerts::FBatchValue* Args, int ArgCount, const char* Data, bool HasResult, puerts::FBatchValue* ResultSlot, char* ResultData, int ResultDataCapacity)
+    {
+        v8::Isolate* Isolate = ResultInfo.Isolate;
+#ifdef THREAD_SAFE
+        v8::Locker Locker(Isolate);
+#endif
+        v8::Isolate::Scope IsolateScope(Isolate);
+        v8::HandleScope HandleScope(Isolate);
+        v8::Local<v8::Context> Context = ResultInfo.Context.Get(Isolate);
+        v8::Context::Scope ContextScope(Context);
+
+        // 常见的委托参数个数都不大，避免每次调用都分配
+        v8::Local<v8::Value> StackArgs[8];
+        std::vector<v8::Local<v8::Value>> HeapArgs;
+        v8::Local<v8::Value>* V8Args = StackArgs;
+        if (ArgCount > 8)
+        {
+            HeapArgs.resize(ArgCount);
+            V8Args = HeapArgs.data();
+        }
+        for (int i = 0; i < ArgCount; ++i)
+        {
+            V8Args[i] = ToV8(Isolate, Context, Args[i], Data);
+        }
+
+        v8::TryCatch TryCatch(Isolate);
+        auto maybeValue = GFunction.Get(Isolate)->Call(Context, Context->Global(), ArgCount, V8Args);
+
+        if (TryCatch.HasCaught())
+        {
+            v8::Local<v8::Value> Exception = TryCatch.Exception();
+            const auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+            JsEngine->SetLastException(Exception);
+            LastException.Reset(Isolate, Exception);
+            LastExceptionInfo = FV8Utils::ExceptionToString(Isolate, Exception);
+            return false;
+        }
+
+        if (HasResult && !maybeValue.IsEmpty())
+        {
+            auto Result = maybeValue.ToLocalChecked();
+            ResultInfo.Result.Reset(Isolate, Result);
+            if (ResultSlot)
+            {
+                ToBatchValue(Isolate, Context, Result, ResultSlot, ResultData, ResultDataCapacity);
+            }
+        }
+        else if (ResultSlot)
+        {
+            ResultSlot->Type = puerts::NullOrUndefined;
+            ResultSlot->Length = 0;
+            ResultSlot->BigInt = 0;
+        }
+        return true;
+    }
+
 }
\ No newline at end of file
@@ -14,8 +14,9 @@ namespace PUERTS_NAMESPACE
 class V8Plugin : public puerts::IPuertsPlugin
 {
 public:
-    V8Plugin(void* external_quickjs_runtime, void* external_quickjs_context)
-        : jsEngine(this, external_quickjs_runtime, external_quickjs_context)
+    V8Plugin(void* external_quickjs_runtime, void* external_quickjs_context, const char* SnapshotData = nullptr, int SnapshotLength = 0,
+        bool PooledArrayBufferAllocator = false)
+        : jsEngine(this, external_quickjs_runtime, external_quickjs_context, SnapshotData, SnapshotLength, PooledArrayBufferAllocator)
     {
     }
     
@@ -31,6 +32,24 @@ public:
 
     virtual void* Eval(const char *Code, const char* Path) override;
 
+    virtual void* EvalWithCodeCache(const char *Code, const char* Path, const uint8_t* CodeCache, int CodeCacheLength, int *CodeCacheRejected) override;
+
+    virtual const uint8_t* CreateCodeCache(const char *Code, const char* Path, int *Length) override;
+
+    virtual void GetCodeCacheStats(int *Produced, int *Accepted, int *Rejected) override;
+
+    virtual bool GetSlabPoolStats(int Index, int *BlockSize, int *InUse, int *HighWater, int *Capacity) override;
+
+    virtual bool GetHandleTableStats(int Kind, int64_t *Lookups, int64_t *Allocations, int64_t *StaleHandles, int *Live) override;
+
+    virtual void SetNodeLoopEventDriven(int Enable) override;
+
+    virtual int HasPendingNodeTask() override;
+
+    virtual void GetNodeLoopStats(int64_t *Wakeups, int64_t *Runs, double *AverageLatencyMs, double *MaxLatencyMs) override;
+
+    virtual void ResetNodeLoopStats() override;
+
     virtual bool ClearModuleCache(const char* Path) override;
     
     virtual int RegisterClass(int BaseTypeId, const char *FullName, puerts::FuncPtr Constructor, puerts::FuncPtr Destructor, int64_t Data, int Size) override;
@@ -79,6 +98,12 @@ public:
 
     virtual void SetStringToOutValue(void* Value, const char *Str) override;
 
+    virtual const uint16_t *GetUtf16StringFromValue(void* Value, int *Length, int IsOut) override;
+
+    virtual void SetUtf16StringToOutValue(void* Value, const uint16_t *Str, int Length) override;
+
+    virtual void SetOneByteStringToOutValue(void* Value, const uint8_t *Str, int Length) override;
+
     virtual int GetBooleanFromValue(void* Value, int IsOut) override;
 
     virtual void SetBooleanToOutValue(void* Value, int B) override;
@@ -93,6 +118,12 @@ public:
 
     virtual void SetArrayBufferToOutValue(void* Value, unsigned char *Bytes, int Length) override;
 
+    virtual void* AcquireArrayBufferFromValue(void* Value, void **Data, int *Length, int IsOut) override;
+
+    virtual void ReleaseArrayBuffer(void *Handle) override;
+
+    virtual void SetExternalArrayBufferToOutValue(void* Value, void *Data, int Length, FuncPtr Release, int64_t UserData) override;
+
     virtual void *GetObjectFromValue(void* Value, int IsOut) override;
 
     virtual int GetTypeIdFromValue(void* Value, int IsOut) override;
@@ -119,10 +150,16 @@ public:
 
     virtual void ReturnString(const void* Info, const char* String) override;
 
+    virtual void ReturnUtf16String(const void* Info, const uint16_t* String, int Length) override;
+
+    virtual void ReturnOneByteString(const void* Info, const uint8_t* String, int Length) override;
+
     virtual void ReturnBigInt(const void* Info, int64_t BigInt) override;
 
     virtual void ReturnArrayBuffer(const void* Info, unsigned char *Bytes, int Length) override;
 
+    virtual void ReturnExternalArrayBuffer(const void* Info, void *Data, int Length, FuncPtr Release, int64_t UserData) override;
+
     virtual void ReturnBoolean(const void* Info, int Bool) override;
 
     virtual void ReturnDate(const void* Info, double Date) override;
@@ -148,8 +185,14 @@ public:
 
     virtual void PushArrayBufferForJSFunction(void* Function, unsigned char * Bytes, int Length) override;
 
+    virtual void PushExternalArrayBufferForJSFunction(void* Function, void *Data, int Length, FuncPtr Release, int64_t UserData) override;
+
     virtual void PushStringForJSFunction(void* Function, const char* S) override;
 
+    virtual void PushUtf16StringForJSFunction(void* Function, const uint16_t* S, int Length) override;
+
+    virtual void PushOneByteStringForJSFunction(void* Function, const uint8_t* S, int Length) override;
+
     virtual void PushNumberForJSFunction(void* Function, double D) override;
 
     virtual void PushObjectForJSFunction(void* Function, int ClassID, void* Ptr) override;
@@ -160,6 +203,8 @@ public:
 
     virtual void* InvokeJSFunction(void* Function, int HasResult) override;
 
+    virtual void* InvokeJSFunctionBatched(void* Function, const puerts::FBatchValue* Args, int ArgCount, const char* Data, int HasResult, puerts::FBatchValue* Result, char* ResultData, int ResultDataCapacity) override;
+
     virtual puerts::JsValueType GetResultType(void* ResultInfo) override;
 
     virtual double GetNumberFromResult(void* ResultInfo) override;
@@ -168,6 +213,8 @@ public:
 
     virtual const char *GetStringFromResult(void* ResultInfo, int *Length) override;
 
+    virtual const uint16_t *GetUtf16StringFromResult(void* ResultInfo, int *Length) override;
+
     virtual int GetBooleanFromResult(void* ResultInfo) override;
 
     virtual int ResultIsBigInt(void* ResultInfo) override;
@@ -238,6 +285,86 @@ void* V8Plugin::Eval(const char *Code, const char* Path)
     }
 }
 
+void* V8Plugin::EvalWithCodeCache(const char *Code, const char* Path, const uint8_t* CodeCache, int CodeCacheLength, int *CodeCacheRejected)
+{
+    bool Rejected = false;
+    bool Success = jsEngine.EvalWithCodeCache(Code, Path, CodeCache, CodeCacheLength, &Rejected);
+    if (CodeCacheRejected)
+    {
+        *CodeCacheRejected = Rejected ? 1 : 0;
+    }
+    return Success ? &(jsEngine.ResultInfo) : nullptr;
+}
+
+const uint8_t* V8Plugin::CreateCodeCache(const char *Code, const char* Path, int *Length)
+{
+    if (!jsEngine.CreateCodeCache(Code, Path))
+    {
+        *Length = 0;
+        return nullptr;
+    }
+    *Length = static_cast<int>(jsEngine.CodeCacheBuffer.size());
+    return jsEngine.CodeCacheBuffer.data();
+}
+
+void V8Plugin::GetCodeCacheStats(int *Produced, int *Accepted, int *Rejected)
+{
+    *Produced = static_cast<int>(jsEngine.BackendEnv.CodeCacheStats.Produced);
+    *Accepted = static_cast<int>(jsEngine.BackendEnv.CodeCacheStats.Accepted);
+    *Rejected = static_cast<int>(jsEngine.BackendEnv.CodeCacheStats.Rejected);
+}
+
+bool V8Plugin::GetSlabPoolStats(int Index, int *BlockSize, int *InUse, int *HighWater, int *Capacity)
+{
+    if (Index < 0 || Index >= jsEngine.SlabAllocator.StatsCount())
+    {
+        return false;
+    }
+    auto Stats = jsEngine.SlabAllocator.GetStats(Index);
+    *BlockSize = static_cast<int>(Stats.BlockSize);
+    *InUse = static_cast<int>(Stats.InUse);
+    *HighWater = static_cast<int>(Stats.HighWater);
+    *Capacity = static_cast<int>(Stats.Capacity);
+    return true;
+}
+
+bool V8Plugin::GetHandleTableStats(int Kind, int64_t *Lookups, int64_t *Allocations, int64_t *StaleHandles, int *Live)
+{
+    PUERTS_NAMESPACE::FHandleTableStats Stats;
+    if (!jsEngine.GetHandleTableStats(Kind, &Stats, Live))
+    {
+        return false;
+    }
+    *Lookups = static_cast<int64_t>(Stats.Lookups);
+    *Allocations = static_cast<int64_t>(Stats.Allocations);
+    *StaleHandles = static_cast<int64_t>(Stats.StaleHandles);
+    return true;
+}
+
+void V8Plugin::SetNodeLoopEventDriven(int Enable)
+{
+    jsEngine.BackendEnv.SetEventDrivenLoop(Enable != 0);
+}
+
+int V8Plugin::HasPendingNodeTask()
+{
+    return jsEngine.BackendEnv.HasPendingTask() ? 1 : 0;
+}
+
+void V8Plugin::GetNodeLoopStats(int64_t *Wakeups, int64_t *Runs, double *AverageLatencyMs, double *MaxLatencyMs)
+{
+    const auto& Stats = jsEngine.BackendEnv.NodeLoopStats;
+    *Wakeups = static_cast<int64_t>(Stats.Wakeups);
+    *Runs = static_cast<int64_t>(Stats.Runs);
+    *AverageLatencyMs = *Runs > 0 ? Stats.LatencyMicrosecondsTotal / 1000.0 / *Runs : 0;
+    *MaxLatencyMs = Stats.LatencyMicrosecondsMax / 1000.0;
+}
+
+void V8Plugin::ResetNodeLoopStats()
+{
+    jsEngine.BackendEnv.NodeLoopStats.Reset();
+}
+
 bool V8Plugin::ClearModuleCache(const char* Path)
 {
     return jsEngine.ClearModuleCache(Path);
@@ -460,6 +587,44 @@ void V8Plugin::SetStringToOutValue(void* pValue, const char *Str)
     }
 }
 
+const uint16_t *V8Plugin::GetUtf16StringFromValue(void* pValue, int *Length, int IsOut)
+{
+    v8::Isolate* Isolate = jsEngine.MainIsolate;
+    v8::Value *Value = (v8::Value *)pValue;
+    auto Context = Isolate->GetCurrentContext();
+    if (IsOut)
+    {
+        auto Outer = Value->ToObject(Context).ToLocalChecked();
+        auto Realvalue = Outer->Get(Context, 0).ToLocalChecked();
+        return PUERTS_NAMESPACE::ToUtf16(Isolate, Context, *Realvalue, jsEngine.Utf16Buffer, Length);
+    }
+    return PUERTS_NAMESPACE::ToUtf16(Isolate, Context, Value, jsEngine.Utf16Buffer, Length);
+}
+
+void V8Plugin::SetUtf16StringToOutValue(void* pValue, const uint16_t *Str, int Length)
+{
+    v8::Isolate* Isolate = jsEngine.MainIsolate;
+    const v8::Value *Value = (const v8::Value *)pValue;
+    if (Value->IsObject())
+    {
+        auto Context = Isolate->GetCurrentContext();
+        auto Outer = Value->ToObject(Context).ToLocalChecked();
+        auto ReturnVal = Outer->Set(Context, 0, FV8Utils::V8Utf16String(Isolate, Str, Length));
+    }
+}
+
+void V8Plugin::SetOneByteStringToOutValue(void* pValue, const uint8_t *Str, int Length)
+{
+    v8::Isolate* Isolate = jsEngine.MainIsolate;
+    const v8::Value *Value = (const v8::Value *)pValue;
+    if (Value->IsObject())
+    {
+        auto Context = Isolate->GetCurrentContext();
+        auto Outer = Value->ToObject(Context).ToLocalChecked();
+        auto ReturnVal = Outer->Set(Context, 0, FV8Utils::V8OneByteString(Isolate, Str, Length));
+    }
+}
+
 int V8Plugin::GetBooleanFromValue(void* pValue, int IsOut)
 {
     v8::Isolate* Isolate = jsEngine.MainIsolate;
@@ -584,6 +749,41 @@ void V8Plugin::SetArrayBufferToOutValue(void* pValue, unsigned char *Bytes, int
     }
 }
 
+void* V8Plugin::AcquireArrayBufferFromValue(void* pValue, void **Data, int *Length, int IsOut)
+{
+    v8::Isolate* Isolate = jsEngine.MainIsolate;
+    v8::Value *Value = (v8::Value *)pValue;
+    if (IsOut)
+    {
+        auto Context = Isolate->GetCurrentContext();
+        auto Outer = Value->ToObject(Context).ToLocalChecked();
+        auto Realvalue = Outer->Get(Context, 0).ToLocalChecked();
+        return PUERTS_NAMESPACE::AcquireArrayBuffer(*Realvalue, Data, Length);
+    }
+    else
+    {
+        return PUERTS_NAMESPACE::AcquireArrayBuffer(Value, Data, Length);
+    }
+}
+
+void V8Plugin::ReleaseArrayBuffer(void *Handle)
+{
+    PUERTS_NAMESPACE::ReleaseArrayBuffer(Handle);
+}
+
+void V8Plugin::SetExternalArrayBufferToOutValue(void* pValue, void *Data, int Length, FuncPtr Release, int64_t UserData)
+{
+    v8::Isolate* Isolate = jsEngine.MainIsolate;
+    const v8::Value *Value = (const v8::Value *)pValue;
+    if (Value->IsObject())
+    {
+        auto Context = Isolate->GetCurrentContext();
+        auto Outer = Value->ToObject(Context).ToLocalChecked();
+        v8::Local<v8::ArrayBuffer> Ab = PUERTS_NAMESPACE::NewExternalArrayBuffer(Isolate, Data, Length, (PUERTS_NAMESPACE::CSharpExternalBufferRelease)Release, UserData);
+        auto ReturnVal = Outer->Set(Context, 0, Ab);
+    }
+}
+
 void* V8Plugin::GetObjectFromValue(void* pValue, int IsOut)
 {
     v8::Isolate* Isolate = jsEngine.MainIsolate;
@@ -749,6 +949,20 @@ void V8Plugin::ReturnString(const void* pInfo, const char* String)
     Info.GetReturnValue().Set(PUERTS_NAMESPACE::FV8Utils::V8String(Isolate, String));
 }
 
+void V8Plugin::ReturnUtf16String(const void* pInfo, const uint16_t* String, int Length)
+{
+    v8::Isolate* Isolate = jsEngine.MainIsolate;
+    const v8::FunctionCallbackInfo<v8::Value>& Info =  *(const v8::FunctionCallbackInfo<v8::Value>*)pInfo;
+    Info.GetReturnValue().Set(PUERTS_NAMESPACE::FV8Utils::V8Utf16String(Isolate, String, Length));
+}
+
+void V8Plugin::ReturnOneByteString(const void* pInfo, const uint8_t* String, int Length)
+{
+    v8::Isolate* Isolate = jsEngine.MainIsolate;
+    const v8::FunctionCallbackInfo<v8::Value>& Info =  *(const v8::FunctionCallbackInfo<v8::Value>*)pInfo;
+    Info.GetReturnValue().Set(PUERTS_NAMESPACE::FV8Utils::V8OneByteString(Isolate, String, Length));
+}
+
 void V8Plugin::ReturnBigInt(const void* pInfo, int64_t BigInt)
 {
     v8::Isolate* Isolate = jsEngine.MainIsolate;
@@ -763,6 +977,13 @@ void V8Plugin::ReturnArrayBuffer(const void* pInfo, unsigned char *Bytes, int Le
     Info.GetReturnValue().Set(PUERTS_NAMESPACE::NewArrayBuffer(Isolate, Bytes, Length));
 }
 
+void V8Plugin::ReturnExternalArrayBuffer(const void* pInfo, void *Data, int Length, FuncPtr Release, int64_t UserData)
+{
+    v8::Isolate* Isolate = jsEngine.MainIsolate;
+    const v8::FunctionCallbackInfo<v8::Value>& Info =  *(const v8::FunctionCallbackInfo<v8::Value>*)pInfo;
+    Info.GetReturnValue().Set(PUERTS_NAMESPACE::NewExternalArrayBuffer(Isolate, Data, Length, (PUERTS_NAMESPACE::CSharpExternalBufferRelease)Release, UserData));
+}
+
 void V8Plugin::ReturnBoolean(const void* pInfo, int Bool)
 {
     const v8::FunctionCallbackInfo<v8::Value>& Info =  *(const v8::FunctionCallbackInfo<v8::Value>*)pInfo;
@@ -868,6 +1089,23 @@ void V8Plugin::PushArrayBufferForJSFunction(void* pFunction, unsigned char * Byt
     Function->Arguments.push_back(std::move(Value));
 }
 
+void V8Plugin::PushExternalArrayBufferForJSFunction(void* pFunction, void *Data, int Length, FuncPtr Release, int64_t UserData)
+{
+    PUERTS_NAMESPACE::JSFunction *Function = (PUERTS_NAMESPACE::JSFunction *)pFunction;
+    auto Isolate = Function->ResultInfo.Isolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Function->ResultInfo.Context.Get(Isolate);
+    v8::Context::Scope ContextScope(Context);
+    FValue Value;
+    Value.Type = puerts::ArrayBuffer;
+    Value.Persistent.Reset(Isolate, PUERTS_NAMESPACE::NewExternalArrayBuffer(Isolate, Data, Length, (PUERTS_NAMESPACE::CSharpExternalBufferRelease)Release, UserData));
+    Function->Arguments.push_back(std::move(Value));
+}
+
 void V8Plugin::PushStringForJSFunction(void* pFunction, const char* S)
 {
     PUERTS_NAMESPACE::JSFunction *Function = (PUERTS_NAMESPACE::JSFunction *)pFunction;
@@ -877,6 +1115,36 @@ void V8Plugin::PushStringForJSFunction(void* pFunction, const char* S)
     Function->Arguments.push_back(std::move(Value));
 }
 
+void V8Plugin::PushUtf16StringForJSFunction(void* pFunction, const uint16_t* S, int Length)
+{
+    PUERTS_NAMESPACE::JSFunction *Function = (PUERTS_NAMESPACE::JSFunction *)pFunction;
+    auto Isolate = Function->ResultInfo.Isolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    FValue Value;
+    Value.Type = puerts::String;
+    Value.Persistent.Reset(Isolate, PUERTS_NAMESPACE::FV8Utils::V8Utf16String(Isolate, S, Length));
+    Function->Arguments.push_back(std::move(Value));
+}
+
+void V8Plugin::PushOneByteStringForJSFunction(void* pFunction, const uint8_t* S, int Length)
+{
+    PUERTS_NAMESPACE::JSFunction *Function = (PUERTS_NAMESPACE::JSFunction *)pFunction;
+    auto Isolate = Function->ResultInfo.Isolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    FValue Value;
+    Value.Type = puerts::String;
+    Value.Persistent.Reset(Isolate, PUERTS_NAMESPACE::FV8Utils::V8OneByteString(Isolate, S, Length));
+    Function->Arguments.push_back(std::move(Value));
+}
+
 void V8Plugin::PushNumberForJSFunction(void* pFunction, double D)
 {
     PUERTS_NAMESPACE::JSFunction *Function = (PUERTS_NAMESPACE::JSFunction *)pFunction;
@@ -935,6 +1203,19 @@ void* V8Plugin::InvokeJSFunction(void* pFunction, int HasResult)
     }
 }
 
+void* V8Plugin::InvokeJSFunctionBatched(void* pFunction, const puerts::FBatchValue* Args, int ArgCount, const char* Data, int HasResult, puerts::FBatchValue* Result, char* ResultData, int ResultDataCapacity)
+{
+    PUERTS_NAMESPACE::JSFunction *Function = (PUERTS_NAMESPACE::JSFunction *)pFunction;
+    if (Function->InvokeBatched(Args, ArgCount, Data, HasResult, Result, ResultData, ResultDataCapacity))
+    {
+        return &(Function->ResultInfo);
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
 puerts::JsValueType V8Plugin::GetResultType(void* pResultInfo)
 {
     PUERTS_NAMESPACE::FResultInfo *ResultInfo = (PUERTS_NAMESPACE::FResultInfo *)pResultInfo;
@@ -1012,6 +1293,21 @@ const char *V8Plugin::GetStringFromResult(void* pResultInfo, int *Length)
     return jsEngine.StrBuffer.data();
 }
 
+const uint16_t *V8Plugin::GetUtf16StringFromResult(void* pResultInfo, int *Length)
+{
+    PUERTS_NAMESPACE::FResultInfo *ResultInfo = (PUERTS_NAMESPACE::FResultInfo *)pResultInfo;
+    v8::Isolate* Isolate = ResultInfo->Isolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = ResultInfo->Context.Get(Isolate);
+    v8::Context::Scope ContextScope(Context);
+
+    return PUERTS_NAMESPACE::ToUtf16(Isolate, Context, *ResultInfo->Result.Get(Isolate), jsEngine.Utf16Buffer, Length);
+}
+
 int V8Plugin::GetBooleanFromResult(void* pResultInfo)
 {
     PUERTS_NAMESPACE::FResultInfo *ResultInfo = (PUERTS_NAMESPACE::FResultInfo *)pResultInfo;
@@ -1208,6 +1504,26 @@ namespace puerts
     {
         return new PUERTS_NAMESPACE::V8Plugin(external_quickjs_runtime, external_quickjs_context);
     }
+
+    IPuertsPlugin* CreateV8PluginWithSnapshot(const char* SnapshotData, int SnapshotLength)
+    {
+        return new PUERTS_NAMESPACE::V8Plugin(nullptr, nullptr, SnapshotData, SnapshotLength);
+    }
+
+    IPuertsPlugin* CreateV8PluginWithPooledAllocator()
+    {
+        return new PUERTS_NAMESPACE::V8Plugin(nullptr, nullptr, nullptr, 0, true);
+    }
+
+    const char* CreateV8Snapshot(const char* BootstrapScript, const char* Path, int* Length, const char** Error)
+    {
+        static std::vector<char> SnapshotBlob;
+        static std::string SnapshotError;
+        bool Success = PUERTS_NAMESPACE::JSEngine::CreateSnapshot(BootstrapScript, Path, SnapshotBlob, SnapshotError);
+        *Error = SnapshotError.c_str();
+        *Length = Success ? static_cast<int>(SnapshotBlob.size()) : 0;
+        return Success ? SnapshotBlob.data() : nullptr;
+    }
 #endif
 
 #ifdef QJS_BACKEND
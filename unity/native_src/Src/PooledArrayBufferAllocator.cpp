@@ -0,0 +1,166 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+#include "PooledArrayBufferAllocator.h"
+
+#if !defined(WITH_QUICKJS)
+
+#include <stdlib.h>
+#include <string.h>
+
+#if PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+FPooledArrayBufferAllocator::~FPooledArrayBufferAllocator()
+{
+    for (auto Chunk : Chunks)
+    {
+        free(Chunk);
+    }
+}
+
+int FPooledArrayBufferAllocator::ClassIndex(size_t Length)
+{
+    int Index = 0;
+    for (size_t Rest = Length <= 1 ? 0 : (Length - 1) >> kMinBlockShift; Rest != 0; Rest >>= 1)
+    {
+        ++Index;
+    }
+    return Index;
+}
+
+void FPooledArrayBufferAllocator::TrackAllocated(uint64_t Bytes)
+{
+    ++Stats.Allocations;
+    Stats.AllocatedBytes += Bytes;
+    if (Stats.AllocatedBytes > Stats.PeakBytes)
+    {
+        Stats.PeakBytes = Stats.AllocatedBytes;
+    }
+}
+
+void* FPooledArrayBufferAllocator::AllocateSmall(int Index)
+{
+    size_t Block = BlockSize(Index);
+    std::lock_guard<std::mutex> Guard(Mutex);
+    if (FreeLists[Index] == nullptr)
+    {
+        char* Chunk = static_cast<char*>(malloc(kChunkSize));
+        if (Chunk == nullptr)
+        {
+            return nullptr;
+        }
+        Chunks.push_back(Chunk);
+        for (size_t i = kChunkSize / Block; i > 0; --i)
+        {
+            FFreeBlock* FreeBlock = reinterpret_cast<FFreeBlock*>(Chunk + (i - 1) * Block);
+            FreeBlock->Next = FreeLists[Index];
+            FreeLists[Index] = FreeBlock;
+        }
+        Stats.PooledBytes += kChunkSize / Block * Block;
+    }
+    else
+    {
+        ++Stats.PoolHits;
+    }
+    FFreeBlock* Result = FreeLists[Index];
+    FreeLists[Index] = Result->Next;
+    Stats.PooledBytes -= Block;
+    TrackAllocated(Block);
+    return Result;
+}
+
+void* FPooledArrayBufferAllocator::AllocateLarge(size_t Length)
+{
+    // 新申请的页由系统清零
+#if PLATFORM_WINDOWS
+    void* Data = VirtualAlloc(nullptr, Length, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+    void* Data = mmap(nullptr, Length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (Data == MAP_FAILED)
+    {
+        Data = nullptr;
+    }
+#endif
+    if (Data)
+    {
+        std::lock_guard<std::mutex> Guard(Mutex);
+        Stats.LargeBytes += Length;
+        TrackAllocated(Length);
+    }
+    return Data;
+}
+
+void FPooledArrayBufferAllocator::FreeLarge(void* Data, size_t Length)
+{
+#if PLATFORM_WINDOWS
+    VirtualFree(Data, 0, MEM_RELEASE);
+#else
+    munmap(Data, Length);
+#endif
+    std::lock_guard<std::mutex> Guard(Mutex);
+    Stats.LargeBytes -= Length;
+    Stats.AllocatedBytes -= Length;
+}
+
+void* FPooledArrayBufferAllocator::Allocate(size_t Length)
+{
+    if (Length > kMaxBlockSize)
+    {
+        return AllocateLarge(Length);
+    }
+    void* Data = AllocateSmall(ClassIndex(Length));
+    // 新chunk来自malloc，复用的块有旧数据，都需要清零
+    if (Data)
+    {
+        memset(Data, 0, Length);
+    }
+    return Data;
+}
+
+void* FPooledArrayBufferAllocator::AllocateUninitialized(size_t Length)
+{
+    if (Length > kMaxBlockSize)
+    {
+        return AllocateLarge(Length);
+    }
+    return AllocateSmall(ClassIndex(Length));
+}
+
+void FPooledArrayBufferAllocator::Free(void* Data, size_t Length)
+{
+    if (Data == nullptr)
+    {
+        return;
+    }
+    if (Length > kMaxBlockSize)
+    {
+        FreeLarge(Data, Length);
+        return;
+    }
+    int Index = ClassIndex(Length);
+    std::lock_guard<std::mutex> Guard(Mutex);
+    FFreeBlock* Block = static_cast<FFreeBlock*>(Data);
+    Block->Next = FreeLists[Index];
+    FreeLists[Index] = Block;
+    Stats.PooledBytes += BlockSize(Index);
+    Stats.AllocatedBytes -= BlockSize(Index);
+}
+
+FArrayBufferAllocatorStats FPooledArrayBufferAllocator::GetStats()
+{
+    std::lock_guard<std::mutex> Guard(Mutex);
+    return Stats;
+}
+}
+
+#endif
@@ -23,6 +23,10 @@ LogCallback GLogCallback = nullptr;
 LogCallback GLogWarningCallback = nullptr;
 LogCallback GLogErrorCallback = nullptr;
 
+// CreateSnapshot的结果，下次调用前有效
+static std::vector<char> GSnapshotBlob;
+static std::string GSnapshotError;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -54,6 +58,42 @@ V8_EXPORT v8::Isolate *CreateJSEngine(int backend)
     return JsEngine->MainIsolate;
 }
 
+// snapshot数据会被拷贝，调用返回后即可释放；非v8后端返回nullptr
+V8_EXPORT v8::Isolate *CreateJSEngineWithSnapshot(int backend, const char* SnapshotData, int SnapshotLength)
+{
+#if WITH_QUICKJS || WITH_NODEJS
+    return nullptr;
+#else
+    auto JsEngine = new JSEngine(nullptr, nullptr, SnapshotData, SnapshotLength);
+    return JsEngine->MainIsolate;
+#endif
+}
+
+// ArrayBuffer使用按块大小分级复用的分配器，适合频繁创建小ArrayBuffer的场景；只对v8后端生效，其它后端等价于CreateJSEngine
+V8_EXPORT v8::Isolate *CreateJSEngineWithPooledAllocator(int backend)
+{
+    auto JsEngine = new JSEngine(nullptr, nullptr, nullptr, 0, true);
+    return JsEngine->MainIsolate;
+}
+
+// 不需要已有的JSEngine，失败返回nullptr，错误信息通过GetSnapshotErrorInfo获取
+V8_EXPORT const char* CreateSnapshot(const char* BootstrapScript, const char* Path, int *Length)
+{
+    if (!JSEngine::CreateSnapshot(BootstrapScript, Path, GSnapshotBlob, GSnapshotError))
+    {
+        *Length = 0;
+        return nullptr;
+    }
+    *Length = static_cast<int>(GSnapshotBlob.size());
+    return GSnapshotBlob.data();
+}
+
+V8_EXPORT const char* GetSnapshotErrorInfo(int *Length)
+{
+    *Length = static_cast<int>(GSnapshotError.size());
+    return GSnapshotError.c_str();
+}
+
 V8_EXPORT v8::Isolate *CreateJSEngineWithExternalEnv(int backend, void* external_quickjs_runtime, void* external_quickjs_context)
 {
 #if WITH_QUICKJS
@@ -96,6 +136,100 @@ V8_EXPORT FResultInfo * Eval(v8::Isolate *Isolate, const char *Code, const char*
     }
 }
 
+V8_EXPORT FResultInfo * EvalWithCodeCache(v8::Isolate *Isolate, const char *Code, const char* Path, const uint8_t* CodeCache, int CodeCacheLength, int *CodeCacheRejected)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    bool Rejected = false;
+    bool Success = JsEngine->EvalWithCodeCache(Code, Path, CodeCache, CodeCacheLength, &Rejected);
+    if (CodeCacheRejected)
+    {
+        *CodeCacheRejected = Rejected ? 1 : 0;
+    }
+    return Success ? &(JsEngine->ResultInfo) : nullptr;
+}
+
+// 返回的指针在下次调用CreateCodeCache前有效，失败返回nullptr，错误信息通过GetLastExceptionInfo获取
+V8_EXPORT const uint8_t* CreateCodeCache(v8::Isolate *Isolate, const char *Code, const char* Path, int *Length)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    if (!JsEngine->CreateCodeCache(Code, Path))
+    {
+        *Length = 0;
+        return nullptr;
+    }
+    *Length = static_cast<int>(JsEngine->CodeCacheBuffer.size());
+    return JsEngine->CodeCacheBuffer.data();
+}
+
+V8_EXPORT void GetCodeCacheStats(v8::Isolate *Isolate, int *Produced, int *Accepted, int *Rejected)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    const auto& Stats = JsEngine->BackendEnv.CodeCacheStats;
+    *Produced = static_cast<int>(Stats.Produced);
+    *Accepted = static_cast<int>(Stats.Accepted);
+    *Rejected = static_cast<int>(Stats.Rejected);
+}
+
+// Index从0开始，超出范围返回false；BlockSize为0的一项是超过最大块大小、直接malloc的分配
+V8_EXPORT bool GetSlabPoolStats(v8::Isolate *Isolate, int Index, int *BlockSize, int *InUse, int *HighWater, int *Capacity)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    if (Index < 0 || Index >= JsEngine->SlabAllocator.StatsCount())
+    {
+        return false;
+    }
+    auto Stats = JsEngine->SlabAllocator.GetStats(Index);
+    *BlockSize = static_cast<int>(Stats.BlockSize);
+    *InUse = static_cast<int>(Stats.InUse);
+    *HighWater = static_cast<int>(Stats.HighWater);
+    *Capacity = static_cast<int>(Stats.Capacity);
+    return true;
+}
+
+// Kind: 0为JSFunction，1为JSObject；StaleHandles是查到已失效句柄的次数，正常情况下应该为0
+V8_EXPORT bool GetHandleTableStats(v8::Isolate *Isolate, int Kind, int64_t *Lookups, int64_t *Allocations, int64_t *StaleHandles, int *Live)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    puerts::FHandleTableStats Stats;
+    if (!JsEngine->GetHandleTableStats(Kind, &Stats, Live))
+    {
+        return false;
+    }
+    *Lookups = static_cast<int64_t>(Stats.Lookups);
+    *Allocations = static_cast<int64_t>(Stats.Allocations);
+    *StaleHandles = static_cast<int64_t>(Stats.StaleHandles);
+    return true;
+}
+
+// 以下几个只对nodejs后端有效：开启事件驱动后宿主每帧先调HasPendingNodeTask，返回非0再LogicTick
+V8_EXPORT void SetNodeLoopEventDriven(v8::Isolate *Isolate, int Enable)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    JsEngine->BackendEnv.SetEventDrivenLoop(Enable != 0);
+}
+
+V8_EXPORT int HasPendingNodeTask(v8::Isolate *Isolate)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    return JsEngine->BackendEnv.HasPendingTask() ? 1 : 0;
+}
+
+V8_EXPORT void GetNodeLoopStats(v8::Isolate *Isolate, int64_t *Wakeups, int64_t *Runs, double *AverageLatencyMs, double *MaxLatencyMs)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    const auto& Stats = JsEngine->BackendEnv.NodeLoopStats;
+    *Wakeups = static_cast<int64_t>(Stats.Wakeups);
+    *Runs = static_cast<int64_t>(Stats.Runs);
+    *AverageLatencyMs = *Runs > 0 ? Stats.LatencyMicrosecondsTotal / 1000.0 / *Runs : 0;
+    *MaxLatencyMs = Stats.LatencyMicrosecondsMax / 1000.0;
+}
+
+V8_EXPORT void ResetNodeLoopStats(v8::Isolate *Isolate)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    JsEngine->BackendEnv.NodeLoopStats.Reset();
+}
+
 V8_EXPORT bool ClearModuleCache(v8::Isolate *Isolate, const char* Path)
 {
     auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
@@ -304,6 +438,40 @@ V8_EXPORT void SetStringToOutValue(v8::Isolate* Isolate, v8::Value *Value, const
     }
 }
 
+// UTF-16版本：和GetStringFromValue一样写到JSEngine的缓冲里返回，不经过UTF-8编解码
+V8_EXPORT const uint16_t *GetUtf16StringFromValue(v8::Isolate* Isolate, v8::Value *Value, int *Length, int IsOut)
+{
+    auto Context = Isolate->GetCurrentContext();
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    if (IsOut)
+    {
+        auto Outer = Value->ToObject(Context).ToLocalChecked();
+        auto Realvalue = Outer->Get(Context, 0).ToLocalChecked();
+        return puerts::ToUtf16(Isolate, Context, *Realvalue, JsEngine->Utf16Buffer, Length);
+    }
+    return puerts::ToUtf16(Isolate, Context, Value, JsEngine->Utf16Buffer, Length);
+}
+
+V8_EXPORT void SetUtf16StringToOutValue(v8::Isolate* Isolate, v8::Value *Value, const uint16_t *Str, int Length)
+{
+    if (Value->IsObject())
+    {
+        auto Context = Isolate->GetCurrentContext();
+        auto Outer = Value->ToObject(Context).ToLocalChecked();
+        auto ReturnVal = Outer->Set(Context, 0, FV8Utils::V8Utf16String(Isolate, Str, Length));
+    }
+}
+
+V8_EXPORT void SetOneByteStringToOutValue(v8::Isolate* Isolate, v8::Value *Value, const uint8_t *Str, int Length)
+{
+    if (Value->IsObject())
+    {
+        auto Context = Isolate->GetCurrentContext();
+        auto Outer = Value->ToObject(Context).ToLocalChecked();
+        auto ReturnVal = Outer->Set(Context, 0, FV8Utils::V8OneByteString(Isolate, Str, Length));
+    }
+}
+
 V8_EXPORT int GetBooleanFromValue(v8::Isolate* Isolate, v8::Value *Value, int IsOut)
 {
     if (IsOut)
@@ -414,6 +582,37 @@ V8_EXPORT void SetArrayBufferToOutValue(v8::Isolate* Isolate, v8::Value *Value,
     }
 }
 
+V8_EXPORT void* AcquireArrayBufferFromValue(v8::Isolate* Isolate, v8::Value *Value, void **Data, int *Length, int IsOut)
+{
+    if (IsOut)
+    {
+        auto Context = Isolate->GetCurrentContext();
+        auto Outer = Value->ToObject(Context).ToLocalChecked();
+        auto Realvalue = Outer->Get(Context, 0).ToLocalChecked();
+        return puerts::AcquireArrayBuffer(*Realvalue, Data, Length);
+    }
+    else
+    {
+        return puerts::AcquireArrayBuffer(Value, Data, Length);
+    }
+}
+
+V8_EXPORT void ReleaseArrayBuffer(v8::Isolate* Isolate, void *Handle)
+{
+    puerts::ReleaseArrayBuffer(Handle);
+}
+
+V8_EXPORT void SetExternalArrayBufferToOutValue(v8::Isolate* Isolate, v8::Value *Value, void *Data, int Length, puerts::CSharpExternalBufferRelease Release, int64_t UserData)
+{
+    if (Value->IsObject())
+    {
+        auto Context = Isolate->GetCurrentContext();
+        auto Outer = Value->ToObject(Context).ToLocalChecked();
+        v8::Local<v8::ArrayBuffer> Ab = puerts::NewExternalArrayBuffer(Isolate, Data, Length, Release, UserData);
+        auto ReturnVal = Outer->Set(Context, 0, Ab);
+    }
+}
+
 V8_EXPORT void *GetObjectFromValue(v8::Isolate* Isolate, v8::Value *Value, int IsOut)
 {
     if (IsOut)
@@ -564,6 +763,16 @@ V8_EXPORT void ReturnString(v8::Isolate* Isolate, const v8::FunctionCallbackInfo
     Info.GetReturnValue().Set(FV8Utils::V8String(Isolate, String));
 }
 
+V8_EXPORT void ReturnUtf16String(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, const uint16_t* String, int Length)
+{
+    Info.GetReturnValue().Set(FV8Utils::V8Utf16String(Isolate, String, Length));
+}
+
+V8_EXPORT void ReturnOneByteString(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, const uint8_t* String, int Length)
+{
+    Info.GetReturnValue().Set(FV8Utils::V8OneByteString(Isolate, String, Length));
+}
+
 V8_EXPORT void ReturnBigInt(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, int64_t BigInt)
 {
     Info.GetReturnValue().Set(v8::BigInt::New(Isolate, BigInt));
@@ -574,6 +783,11 @@ V8_EXPORT void ReturnArrayBuffer(v8::Isolate* Isolate, const v8::FunctionCallbac
     Info.GetReturnValue().Set(puerts::NewArrayBuffer(Isolate, Bytes, Length));
 }
 
+V8_EXPORT void ReturnExternalArrayBuffer(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void *Data, int Length, puerts::CSharpExternalBufferRelease Release, int64_t UserData)
+{
+    Info.GetReturnValue().Set(puerts::NewExternalArrayBuffer(Isolate, Data, Length, Release, UserData));
+}
+
 V8_EXPORT void ReturnBoolean(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, int Bool)
 {
     Info.GetReturnValue().Set(Bool ? true : false);
@@ -664,6 +878,22 @@ V8_EXPORT void PushArrayBufferForJSFunction(JSFunction *Function, unsigned char
     Function->Arguments.push_back(std::move(Value));
 }
 
+V8_EXPORT void PushExternalArrayBufferForJSFunction(JSFunction *Function, void *Data, int Length, puerts::CSharpExternalBufferRelease Release, int64_t UserData)
+{
+    auto Isolate = Function->ResultInfo.Isolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Function->ResultInfo.Context.Get(Isolate);
+    v8::Context::Scope ContextScope(Context);
+    FValue Value;
+    Value.Type = puerts::ArrayBuffer;
+    Value.Persistent.Reset(Isolate, puerts::NewExternalArrayBuffer(Isolate, Data, Length, Release, UserData));
+    Function->Arguments.push_back(std::move(Value));
+}
+
 V8_EXPORT void PushStringForJSFunction(JSFunction *Function, const char* S)
 {
     FValue Value;
@@ -672,6 +902,34 @@ V8_EXPORT void PushStringForJSFunction(JSFunction *Function, const char* S)
     Function->Arguments.push_back(std::move(Value));
 }
 
+V8_EXPORT void PushUtf16StringForJSFunction(JSFunction *Function, const uint16_t* S, int Length)
+{
+    auto Isolate = Function->ResultInfo.Isolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    FValue Value;
+    Value.Type = puerts::String;
+    Value.Persistent.Reset(Isolate, FV8Utils::V8Utf16String(Isolate, S, Length));
+    Function->Arguments.push_back(std::move(Value));
+}
+
+V8_EXPORT void PushOneByteStringForJSFunction(JSFunction *Function, const uint8_t* S, int Length)
+{
+    auto Isolate = Function->ResultInfo.Isolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    FValue Value;
+    Value.Type = puerts::String;
+    Value.Persistent.Reset(Isolate, FV8Utils::V8OneByteString(Isolate, S, Length));
+    Function->Arguments.push_back(std::move(Value));
+}
+
 V8_EXPORT void PushNumberForJSFunction(JSFunction *Function, double D)
 {
     FValue Value;
@@ -726,6 +984,18 @@ V8_EXPORT FResultInfo *InvokeJSFunction(JSFunction *Function, int HasResult)
     }
 }
 
+V8_EXPORT FResultInfo *InvokeJSFunctionBatched(JSFunction *Function, const puerts::FBatchValue* Args, int ArgCount, const char* Data, int HasResult, puerts::FBatchValue* Result, char* ResultData, int ResultDataCapacity)
+{
+    if (Function->InvokeBatched(Args, ArgCount, Data, HasResult, Result, ResultData, ResultDataCapacity))
+    {
+        return &(Function->ResultInfo);
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
 V8_EXPORT JsValueType GetResultType(FResultInfo *ResultInfo)
 {
     if (ResultInfo->Result.IsEmpty())
@@ -800,6 +1070,21 @@ V8_EXPORT const char *GetStringFromResult(FResultInfo *ResultInfo, int *Length)
     return JsEngine->StrBuffer.data();
 }
 
+V8_EXPORT const uint16_t *GetUtf16StringFromResult(FResultInfo *ResultInfo, int *Length)
+{
+    v8::Isolate* Isolate = ResultInfo->Isolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = ResultInfo->Context.Get(Isolate);
+    v8::Context::Scope ContextScope(Context);
+
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    return puerts::ToUtf16(Isolate, Context, *ResultInfo->Result.Get(Isolate), JsEngine->Utf16Buffer, Length);
+}
+
 V8_EXPORT int GetBooleanFromResult(FResultInfo *ResultInfo)
 {
     v8::Isolate* Isolate = ResultInfo->Isolate;
@@ -39,6 +39,8 @@ LogCallback GLogCallback = nullptr;
 LogCallback GLogWarningCallback = nullptr;
 LogCallback GLogErrorCallback = nullptr;
 
+static const char* GSnapshotError = "";
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -76,6 +78,47 @@ PUERTS_EXPORT puerts::IPuertsPlugin* CreateJSEngine(int backend)
     return nullptr;
 }
 
+// 只有v8后端支持snapshot，其它后端返回nullptr
+PUERTS_EXPORT puerts::IPuertsPlugin* CreateJSEngineWithSnapshot(int backend, const char* SnapshotData, int SnapshotLength)
+{
+#ifdef V8_BACKEND
+    if (0 == backend)
+    {
+        return puerts::CreateV8PluginWithSnapshot(SnapshotData, SnapshotLength);
+    }
+#endif
+    return nullptr;
+}
+
+// 池化ArrayBuffer分配器只有v8后端支持，其它后端退化为普通的CreateJSEngine
+PUERTS_EXPORT puerts::IPuertsPlugin* CreateJSEngineWithPooledAllocator(int backend)
+{
+#ifdef V8_BACKEND
+    if (0 == backend)
+    {
+        return puerts::CreateV8PluginWithPooledAllocator();
+    }
+#endif
+    return CreateJSEngine(backend);
+}
+
+PUERTS_EXPORT const char* CreateSnapshot(const char* BootstrapScript, const char* Path, int *Length)
+{
+#ifdef V8_BACKEND
+    return puerts::CreateV8Snapshot(BootstrapScript, Path, Length, &GSnapshotError);
+#else
+    GSnapshotError = "snapshot is not supported by current backend";
+    *Length = 0;
+    return nullptr;
+#endif
+}
+
+PUERTS_EXPORT const char* GetSnapshotErrorInfo(int *Length)
+{
+    *Length = static_cast<int>(strlen(GSnapshotError));
+    return GSnapshotError;
+}
+
 PUERTS_EXPORT puerts::IPuertsPlugin* CreateJSEngineWithExternalEnv(int backend, void* external_quickjs_runtime, void* external_quickjs_context)
 {
 #if QJS_BACKEND
@@ -114,6 +157,58 @@ PUERTS_EXPORT void* Eval(puerts::IPuertsPlugin* plugin, const char *Code, const
     }
 }
 
+PUERTS_EXPORT void* EvalWithCodeCache(puerts::IPuertsPlugin* plugin, const char *Code, const char* Path, const uint8_t* CodeCache, int CodeCacheLength, int *CodeCacheRejected)
+{
+    if (plugin->EvalWithCodeCache(Code, Path, CodeCache, CodeCacheLength, CodeCacheRejected))
+    {
+        return plugin->GetResultInfo();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+PUERTS_EXPORT const uint8_t* CreateCodeCache(puerts::IPuertsPlugin* plugin, const char *Code, const char* Path, int *Length)
+{
+    return plugin->CreateCodeCache(Code, Path, Length);
+}
+
+PUERTS_EXPORT void GetCodeCacheStats(puerts::IPuertsPlugin* plugin, int *Produced, int *Accepted, int *Rejected)
+{
+    plugin->GetCodeCacheStats(Produced, Accepted, Rejected);
+}
+
+PUERTS_EXPORT bool GetSlabPoolStats(puerts::IPuertsPlugin* plugin, int Index, int *BlockSize, int *InUse, int *HighWater, int *Capacity)
+{
+    return plugin->GetSlabPoolStats(Index, BlockSize, InUse, HighWater, Capacity);
+}
+
+PUERTS_EXPORT bool GetHandleTableStats(puerts::IPuertsPlugin* plugin, int Kind, int64_t *Lookups, int64_t *Allocations, int64_t *StaleHandles, int *Live)
+{
+    return plugin->GetHandleTableStats(Kind, Lookups, Allocations, StaleHandles, Live);
+}
+
+PUERTS_EXPORT void SetNodeLoopEventDriven(puerts::IPuertsPlugin* plugin, int Enable)
+{
+    plugin->SetNodeLoopEventDriven(Enable);
+}
+
+PUERTS_EXPORT int HasPendingNodeTask(puerts::IPuertsPlugin* plugin)
+{
+    return plugin->HasPendingNodeTask();
+}
+
+PUERTS_EXPORT void GetNodeLoopStats(puerts::IPuertsPlugin* plugin, int64_t *Wakeups, int64_t *Runs, double *AverageLatencyMs, double *MaxLatencyMs)
+{
+    plugin->GetNodeLoopStats(Wakeups, Runs, AverageLatencyMs, MaxLatencyMs);
+}
+
+PUERTS_EXPORT void ResetNodeLoopStats(puerts::IPuertsPlugin* plugin)
+{
+    plugin->ResetNodeLoopStats();
+}
+
 PUERTS_EXPORT bool ClearModuleCache(puerts::IPuertsPlugin* plugin, const char* Path)
 {
     return plugin->ClearModuleCache(Path);
@@ -222,6 +317,21 @@ PUERTS_EXPORT void SetStringToOutValue(puerts::IPuertsPlugin* plugin, void* Valu
     plugin->SetStringToOutValue(Value, Str);
 }
 
+PUERTS_EXPORT const uint16_t *GetUtf16StringFromValue(puerts::IPuertsPlugin* plugin, void* Value, int *Length, int IsOut)
+{
+    return plugin->GetUtf16StringFromValue(Value, Length, IsOut);
+}
+
+PUERTS_EXPORT void SetUtf16StringToOutValue(puerts::IPuertsPlugin* plugin, void* Value, const uint16_t *Str, int Length)
+{
+    plugin->SetUtf16StringToOutValue(Value, Str, Length);
+}
+
+PUERTS_EXPORT void SetOneByteStringToOutValue(puerts::IPuertsPlugin* plugin, void* Value, const uint8_t *Str, int Length)
+{
+    plugin->SetOneByteStringToOutValue(Value, Str, Length);
+}
+
 PUERTS_EXPORT int GetBooleanFromValue(puerts::IPuertsPlugin* plugin, void* Value, int IsOut)
 {
     return plugin->GetBooleanFromValue(Value, IsOut);
@@ -257,6 +367,21 @@ PUERTS_EXPORT void SetArrayBufferToOutValue(puerts::IPuertsPlugin* plugin, void*
     plugin->SetArrayBufferToOutValue(Value, Bytes, Length);
 }
 
+PUERTS_EXPORT void* AcquireArrayBufferFromValue(puerts::IPuertsPlugin* plugin, void* Value, void **Data, int *Length, int IsOut)
+{
+    return plugin->AcquireArrayBufferFromValue(Value, Data, Length, IsOut);
+}
+
+PUERTS_EXPORT void ReleaseArrayBuffer(puerts::IPuertsPlugin* plugin, void *Handle)
+{
+    plugin->ReleaseArrayBuffer(Handle);
+}
+
+PUERTS_EXPORT void SetExternalArrayBufferToOutValue(puerts::IPuertsPlugin* plugin, void* Value, void *Data, int Length, puerts::FuncPtr Release, int64_t UserData)
+{
+    plugin->SetExternalArrayBufferToOutValue(Value, Data, Length, Release, UserData);
+}
+
 PUERTS_EXPORT void *GetObjectFromValue(puerts::IPuertsPlugin* plugin, void* Value, int IsOut)
 {
     return plugin->GetObjectFromValue(Value, IsOut);
@@ -321,6 +446,16 @@ PUERTS_EXPORT void ReturnString(puerts::IPuertsPlugin* plugin, const void* Info,
     plugin->ReturnString(Info, String);
 }
 
+PUERTS_EXPORT void ReturnUtf16String(puerts::IPuertsPlugin* plugin, const void* Info, const uint16_t* String, int Length)
+{
+    plugin->ReturnUtf16String(Info, String, Length);
+}
+
+PUERTS_EXPORT void ReturnOneByteString(puerts::IPuertsPlugin* plugin, const void* Info, const uint8_t* String, int Length)
+{
+    plugin->ReturnOneByteString(Info, String, Length);
+}
+
 PUERTS_EXPORT void ReturnBigInt(puerts::IPuertsPlugin* plugin, const void* Info, int64_t BigInt)
 {
     plugin->ReturnBigInt(Info, BigInt);
@@ -331,6 +466,11 @@ PUERTS_EXPORT void ReturnArrayBuffer(puerts::IPuertsPlugin* plugin, const void*
     plugin->ReturnArrayBuffer(Info, Bytes, Length);
 }
 
+PUERTS_EXPORT void ReturnExternalArrayBuffer(puerts::IPuertsPlugin* plugin, const void* Info, void *Data, int Length, puerts::FuncPtr Release, int64_t UserData)
+{
+    plugin->ReturnExternalArrayBuffer(Info, Data, Length, Release, UserData);
+}
+
 PUERTS_EXPORT void ReturnBoolean(puerts::IPuertsPlugin* plugin, const void* Info, int Bool)
 {
     plugin->ReturnBoolean(Info, Bool);
@@ -390,11 +530,26 @@ PUERTS_EXPORT void PushArrayBufferForJSFunction(puerts::PuertsPluginStore* Funct
     Function->PuertsPlugin->PushArrayBufferForJSFunction(Function, Bytes, Length);
 }
 
+PUERTS_EXPORT void PushExternalArrayBufferForJSFunction(puerts::PuertsPluginStore* Function, void *Data, int Length, puerts::FuncPtr Release, int64_t UserData)
+{
+    Function->PuertsPlugin->PushExternalArrayBufferForJSFunction(Function, Data, Length, Release, UserData);
+}
+
 PUERTS_EXPORT void PushStringForJSFunction(puerts::PuertsPluginStore* Function, const char* S)
 {
     Function->PuertsPlugin->PushStringForJSFunction(Function, S);
 }
 
+PUERTS_EXPORT void PushUtf16StringForJSFunction(puerts::PuertsPluginStore* Function, const uint16_t* S, int Length)
+{
+    Function->PuertsPlugin->PushUtf16StringForJSFunction(Function, S, Length);
+}
+
+PUERTS_EXPORT void PushOneByteStringForJSFunction(puerts::PuertsPluginStore* Function, const uint8_t* S, int Length)
+{
+    Function->PuertsPlugin->PushOneByteStringForJSFunction(Function, S, Length);
+}
+
 PUERTS_EXPORT void PushNumberForJSFunction(puerts::PuertsPluginStore* Function, double D)
 {
     Function->PuertsPlugin->PushNumberForJSFunction(Function, D);
@@ -420,6 +575,11 @@ PUERTS_EXPORT void* InvokeJSFunction(puerts::PuertsPluginStore* Function, int Ha
     return Function->PuertsPlugin->InvokeJSFunction(Function, HasResult);
 }
 
+PUERTS_EXPORT void* InvokeJSFunctionBatched(puerts::PuertsPluginStore* Function, const puerts::FBatchValue* Args, int ArgCount, const char* Data, int HasResult, puerts::FBatchValue* Result, char* ResultData, int ResultDataCapacity)
+{
+    return Function->PuertsPlugin->InvokeJSFunctionBatched(Function, Args, ArgCount, Data, HasResult, Result, ResultData, ResultDataCapacity);
+}
+
 PUERTS_EXPORT puerts::JsValueType GetResultType(puerts::PuertsPluginStore* ResultInfo)
 {
     return ResultInfo->PuertsPlugin->GetResultType(ResultInfo);
@@ -440,6 +600,11 @@ PUERTS_EXPORT const char *GetStringFromResult(puerts::PuertsPluginStore* ResultI
     return ResultInfo->PuertsPlugin->GetStringFromResult(ResultInfo, Length);
 }
 
+PUERTS_EXPORT const uint16_t *GetUtf16StringFromResult(puerts::PuertsPluginStore* ResultInfo, int *Length)
+{
+    return ResultInfo->PuertsPlugin->GetUtf16StringFromResult(ResultInfo, Length);
+}
+
 PUERTS_EXPORT int GetBooleanFromResult(puerts::PuertsPluginStore* ResultInfo)
 {
     return ResultInfo->PuertsPlugin->GetBooleanFromResult(ResultInfo);
@@ -17,6 +17,7 @@ PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
 PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 
 #include <unordered_map>
+#include <string>
 #include "JSClassRegister.h"
 #include "ObjectCacheNode.h"
 #include "ObjectMapper.h"
@@ -77,6 +78,10 @@ public:
 
     virtual v8::MaybeLocal<v8::Function> LoadTypeById(v8::Local<v8::Context> Context, const void* TypeId) override;
 
+#ifndef WITH_QUICKJS
+    virtual const v8::Eternal<v8::String>* InternPropertyKey(v8::Isolate* Isolate, const char* Key) override;
+#endif
+
     void UnInitialize(v8::Isolate* InIsolate);
 
     v8::Local<v8::FunctionTemplate> GetTemplateOfClass(v8::Isolate* Isolate, const JSClassDefinition* ClassDefinition);
@@ -91,6 +96,9 @@ private:
     std::vector<PesapiCallbackData*> FunctionDatas;
 #ifndef WITH_QUICKJS
     v8::Global<v8::Symbol> PrivateKey;
+
+    // unordered_map的元素地址在rehash后不变，可以直接作为pesapi_property_key
+    std::unordered_map<std::string, v8::Eternal<v8::String>> PropertyKeys;
 #endif
 
     std::shared_ptr<int> Ref = std::make_shared<int>(0);
@@ -51,6 +51,11 @@ public:
 
     virtual std::weak_ptr<int> GetJsEnvLifeCycleTracker() = 0;
 
+#ifndef WITH_QUICKJS
+    // 返回驻留的属性名，同一个Key总是返回同一个地址，在UnInitialize前有效
+    virtual const v8::Eternal<v8::String>* InternPropertyKey(v8::Isolate* Isolate, const char* Key) = 0;
+#endif
+
     virtual ~ICppObjectMapper()
     {
     }
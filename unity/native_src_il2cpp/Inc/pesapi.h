@@ -123,6 +123,7 @@ typedef struct pesapi_scope__* pesapi_scope;
 typedef struct pesapi_type_info__* pesapi_type_info;
 typedef struct pesapi_signature_info__* pesapi_signature_info;
 typedef struct pesapi_property_descriptor__* pesapi_property_descriptor;
+typedef struct pesapi_property_key__* pesapi_property_key;
 
 typedef void (*pesapi_callback)(struct pesapi_ffi* apis, pesapi_callback_info info);
 typedef void* (*pesapi_constructor)(struct pesapi_ffi* apis, pesapi_callback_info info);
@@ -233,6 +234,13 @@ typedef pesapi_value (*pesapi_eval_func)(pesapi_env env, const uint8_t* code, si
 typedef pesapi_value (*pesapi_global_func)(pesapi_env env);
 typedef const void* (*pesapi_get_env_private_func)(pesapi_env env);
 typedef void (*pesapi_set_env_private_func)(pesapi_env env, const void* ptr);
+typedef pesapi_value (*pesapi_eval_with_code_cache_func)(pesapi_env env, const uint8_t* code, size_t code_size, const char* path,
+    const uint8_t* code_cache, size_t code_cache_size, int* code_cache_rejected);
+typedef pesapi_value (*pesapi_create_code_cache_func)(pesapi_env env, const uint8_t* code, size_t code_size, const char* path);
+// the same key always maps to the same handle in an env, the handle is owned by the env and valid until the env is destroyed
+typedef pesapi_property_key (*pesapi_intern_property_key_func)(pesapi_env env, const char* key);
+typedef pesapi_value (*pesapi_get_property_by_key_func)(pesapi_env env, pesapi_value object, pesapi_property_key key);
+typedef void (*pesapi_set_property_by_key_func)(pesapi_env env, pesapi_value object, pesapi_property_key key, pesapi_value value);
 
 struct pesapi_ffi
 {
@@ -318,6 +326,11 @@ struct pesapi_ffi
     pesapi_global_func global;
     pesapi_get_env_private_func get_env_private;
     pesapi_set_env_private_func set_env_private;
+    pesapi_eval_with_code_cache_func eval_with_code_cache;
+    pesapi_create_code_cache_func create_code_cache;
+    pesapi_intern_property_key_func intern_property_key;
+    pesapi_get_property_by_key_func get_property_by_key;
+    pesapi_set_property_by_key_func set_property_by_key;
 };
 
 PESAPI_EXTERN pesapi_type_info pesapi_alloc_type_infos(size_t count);
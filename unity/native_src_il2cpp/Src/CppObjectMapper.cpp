@@ -64,6 +64,23 @@ v8::MaybeLocal<v8::Function> FCppObjectMapper::LoadTypeById(v8::Local<v8::Contex
     return Template->GetFunction(Context);
 }
 
+#ifndef WITH_QUICKJS
+const v8::Eternal<v8::String>* FCppObjectMapper::InternPropertyKey(v8::Isolate* Isolate, const char* Key)
+{
+    auto Iter = PropertyKeys.find(Key);
+    if (Iter != PropertyKeys.end())
+    {
+        return &Iter->second;
+    }
+    v8::Local<v8::String> Name;
+    if (!v8::String::NewFromUtf8(Isolate, Key, v8::NewStringType::kInternalized).ToLocal(&Name))
+    {
+        return nullptr;
+    }
+    return &PropertyKeys.emplace(Key, v8::Eternal<v8::String>(Isolate, Name)).first->second;
+}
+#endif
+
 static void PointerNew(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     // do nothing
@@ -453,6 +470,7 @@ void FCppObjectMapper::UnInitialize(v8::Isolate* InIsolate)
     TypeIdToTemplateMap.clear();
 #ifndef WITH_QUICKJS
     PrivateKey.Reset();
+    PropertyKeys.clear();
 #endif
     PointerTemplate.Reset();
 }
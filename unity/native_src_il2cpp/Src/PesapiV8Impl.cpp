@@ -12,6 +12,7 @@
 #include "DataTransfer.h"
 #include "JSClassRegister.h"
 #include "ObjectMapper.h"
+#include "BackendEnv.h"
 
 #include <string>
 #include <sstream>
@@ -747,6 +748,44 @@ void pesapi_set_property_uint32(pesapi_env env, pesapi_value pobject, uint32_t k
     }
 }
 
+pesapi_property_key pesapi_intern_property_key(pesapi_env env, const char* key)
+{
+    auto context = v8impl::V8LocalContextFromPesapiEnv(env);
+    auto isolate = context->GetIsolate();
+    return reinterpret_cast<pesapi_property_key>(const_cast<v8::Eternal<v8::String>*>(
+        puerts::DataTransfer::IsolateData<puerts::ICppObjectMapper>(isolate)->InternPropertyKey(isolate, key)));
+}
+
+pesapi_value pesapi_get_property_by_key(pesapi_env env, pesapi_value pobject, pesapi_property_key key)
+{
+    auto context = v8impl::V8LocalContextFromPesapiEnv(env);
+    auto object = v8impl::V8LocalValueFromPesapiValue(pobject);
+    if (key && object->IsObject())
+    {
+        auto MaybeValue =
+            object.As<v8::Object>()->Get(context, reinterpret_cast<v8::Eternal<v8::String>*>(key)->Get(context->GetIsolate()));
+        v8::Local<v8::Value> Val;
+        if (MaybeValue.ToLocal(&Val))
+        {
+            return v8impl::PesapiValueFromV8LocalValue(Val);
+        }
+    }
+    return pesapi_create_undefined(env);
+}
+
+void pesapi_set_property_by_key(pesapi_env env, pesapi_value pobject, pesapi_property_key key, pesapi_value pvalue)
+{
+    auto context = v8impl::V8LocalContextFromPesapiEnv(env);
+    auto object = v8impl::V8LocalValueFromPesapiValue(pobject);
+    auto value = v8impl::V8LocalValueFromPesapiValue(pvalue);
+
+    if (key && object->IsObject())
+    {
+        auto _un_used = object.As<v8::Object>()->Set(
+            context, reinterpret_cast<v8::Eternal<v8::String>*>(key)->Get(context->GetIsolate()), value);
+    }
+}
+
 pesapi_value pesapi_call_function(pesapi_env env, pesapi_value pfunc, pesapi_value this_object, int argc, const pesapi_value argv[])
 {
     auto context = v8impl::V8LocalContextFromPesapiEnv(env);
@@ -765,14 +804,16 @@ pesapi_value pesapi_call_function(pesapi_env env, pesapi_value pfunc, pesapi_val
     return v8impl::PesapiValueFromV8LocalValue(maybe_ret.ToLocalChecked());
 }
 
-pesapi_value pesapi_eval(pesapi_env env, const uint8_t* code, size_t code_size, const char* path)
+// code_cache不可用时回退到源码编译，code_cache_rejected(可为空)置1，调用者可据此重新生成cache
+pesapi_value pesapi_eval_with_code_cache(pesapi_env env, const uint8_t* code, size_t code_size, const char* path,
+    const uint8_t* code_cache, size_t code_cache_size, int* code_cache_rejected)
 {
     auto context = v8impl::V8LocalContextFromPesapiEnv(env);
     auto isolate = context->GetIsolate();
     v8::Local<v8::String> url =
         v8::String::NewFromUtf8(isolate, path == nullptr ? "" : path, v8::NewStringType::kNormal).ToLocalChecked();
     std::vector<char> buff;
-    buff.reserve(code_size + 1);
+    buff.resize(code_size + 1);
     memcpy(buff.data(), code, code_size);
     buff.data()[code_size] = '\0';
     v8::Local<v8::String> source = v8::String::NewFromUtf8(isolate, buff.data(), v8::NewStringType::kNormal).ToLocalChecked();
@@ -782,7 +823,13 @@ pesapi_value pesapi_eval(pesapi_env env, const uint8_t* code, size_t code_size,
     v8::ScriptOrigin origin(url);
 #endif
 
-    auto CompiledScript = v8::Script::Compile(context, source, &origin);
+    auto backend_env = static_cast<puerts::FBackendEnv*>(isolate->GetData(BACKENDENV_DATA_POS));
+    bool rejected = false;
+    auto CompiledScript = backend_env->CompileScript(isolate, context, source, &origin, code_cache, code_cache_size, &rejected);
+    if (code_cache_rejected)
+    {
+        *code_cache_rejected = rejected ? 1 : 0;
+    }
     if (CompiledScript.IsEmpty())
     {
         return nullptr;
@@ -795,6 +842,44 @@ pesapi_value pesapi_eval(pesapi_env env, const uint8_t* code, size_t code_size,
     return v8impl::PesapiValueFromV8LocalValue(maybe_ret.ToLocalChecked());
 }
 
+pesapi_value pesapi_eval(pesapi_env env, const uint8_t* code, size_t code_size, const char* path)
+{
+    return pesapi_eval_with_code_cache(env, code, code_size, path, nullptr, 0, nullptr);
+}
+
+// 只编译不执行，返回装着cache的ArrayBuffer，编译失败返回nullptr(异常留在env上)
+pesapi_value pesapi_create_code_cache(pesapi_env env, const uint8_t* code, size_t code_size, const char* path)
+{
+    auto context = v8impl::V8LocalContextFromPesapiEnv(env);
+    auto isolate = context->GetIsolate();
+    v8::Local<v8::String> url =
+        v8::String::NewFromUtf8(isolate, path == nullptr ? "" : path, v8::NewStringType::kNormal).ToLocalChecked();
+    v8::Local<v8::String> source =
+        v8::String::NewFromUtf8(isolate, reinterpret_cast<const char*>(code), v8::NewStringType::kNormal, static_cast<int>(code_size))
+            .ToLocalChecked();
+#if V8_MAJOR_VERSION > 8
+    v8::ScriptOrigin origin(isolate, url);
+#else
+    v8::ScriptOrigin origin(url);
+#endif
+
+    v8::Local<v8::Script> script;
+    if (!v8::Script::Compile(context, source, &origin).ToLocal(&script))
+    {
+        return nullptr;
+    }
+    auto backend_env = static_cast<puerts::FBackendEnv*>(isolate->GetData(BACKENDENV_DATA_POS));
+    std::vector<uint8_t> cache;
+    if (!backend_env->CreateCodeCache(script, cache))
+    {
+        return nullptr;
+    }
+    // NewArrayBuffer不拷贝数据，cache在函数返回后就释放了，所以这里分配一块v8自己持有的内存
+    auto ab = v8::ArrayBuffer::New(isolate, cache.size());
+    memcpy(puerts::DataTransfer::GetArrayBufferData(ab), cache.data(), cache.size());
+    return v8impl::PesapiValueFromV8LocalValue(ab);
+}
+
 pesapi_value pesapi_global(pesapi_env env)
 {
     auto context = v8impl::V8LocalContextFromPesapiEnv(env);
@@ -896,7 +981,12 @@ pesapi_ffi g_pesapi_ffi {
     &pesapi_eval,
     &pesapi_global,
     &pesapi_get_env_private,
-    &pesapi_set_env_private
+    &pesapi_set_env_private,
+    &pesapi_eval_with_code_cache,
+    &pesapi_create_code_cache,
+    &pesapi_intern_property_key,
+    &pesapi_get_property_by_key,
+    &pesapi_set_property_by_key
 };
 
 }    // namespace v8impl
@@ -203,6 +203,13 @@ V8_EXPORT void LogicTick(puerts::JSEnv* jsEnv)
     jsEnv->BackendEnv.LogicTick();
 }
 
+V8_EXPORT void GetCodeCacheStats(puerts::JSEnv* jsEnv, int* Produced, int* Accepted, int* Rejected)
+{
+    *Produced = static_cast<int>(jsEnv->BackendEnv.CodeCacheStats.Produced);
+    *Accepted = static_cast<int>(jsEnv->BackendEnv.CodeCacheStats.Accepted);
+    *Rejected = static_cast<int>(jsEnv->BackendEnv.CodeCacheStats.Rejected);
+}
+
 V8_EXPORT pesapi_ffi* GetFFIApi()
 {
     return &v8impl::g_pesapi_ffi;
@@ -3,9 +3,30 @@
 #include <sstream>
 #include <map>
 #include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(PLATFORM_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#ifndef S_ISDIR
+#define S_ISDIR(m) (((m) & S_IFMT) == S_IFDIR)
+#endif
+#else
+#include <dirent.h>
+#endif
 
 #include "libplatform/libplatform.h"
 #include "v8.h"
+#include "CodeCache.h"
 
 bool endsWith(const std::string &fullString, const std::string &ending) {
     if (fullString.length() >= ending.length()) {
@@ -41,34 +62,388 @@ v8::MaybeLocal<T> CompileString(v8::Local<v8::Context> context,
   return result;
 }
 
-struct CodeCacheHeader {
-    uint32_t MagicNumber;
-    uint32_t VersionHash;
-    uint32_t SourceHash;
-    uint32_t FlagHash;
-    uint32_t PayloadLength;
-    uint32_t Checksum;
+typedef puerts::FCodeCacheHeader CodeCacheHeader;
+
+struct CompileJob {
+    std::string filename;
+    // 运行时加载该文件用的路径，bundle里按它的hash索引
+    std::string url;
+    bool is_module = false;
+};
+
+struct CompileResult {
+    std::vector<uint8_t> data;
+    int source_length = 0;
+    double elapsed_ms = 0;
+    std::string error;
 };
 
+bool readFile(const std::string& filename, std::string& content) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    content = buffer.str();
+    return true;
+}
+
+std::string outputFilename(const std::string& filename, bool is_module) {
+    auto dot_pos = filename.find_last_of('.');
+    return filename.substr(0, dot_pos == std::string::npos ? filename.size(): dot_pos) + (is_module ? ".mbc" : ".cbc");
+}
+
+bool writeFile(const std::string& filename, const std::vector<uint8_t>& data) {
+    std::ofstream output_file(filename, std::ios::binary);
+    if (!output_file.is_open()) {
+        return false;
+    }
+    output_file.write((const char*)data.data(), data.size());
+    return true;
+}
+
+// 在调用者提供的context里编译，不执行；单文件和批量模式共用
+bool compileCodeCache(v8::Isolate* isolate, v8::Local<v8::Context> context, std::string content, const std::string& url,
+                      bool is_module, bool no_cjs_wrap, int ln, int col, CompileResult& result) {
+    v8::HandleScope handle_scope(isolate);
+    v8::TryCatch try_catch(isolate);
+    auto begin = std::chrono::steady_clock::now();
+
+    v8::ScriptCompiler::CachedData* cached_data = nullptr;
+    auto script_url = v8::String::NewFromUtf8(isolate, url.c_str()).ToLocalChecked();
+    if (!is_module && !no_cjs_wrap) {
+        content = "(function (exports, require, module, __filename, __dirname) { " + content + "\n});";
+    }
+    v8::Local<v8::String> source =
+        v8::String::NewFromUtf8(isolate, content.c_str(), v8::NewStringType::kNormal, (int)content.size()).ToLocalChecked();
+    result.source_length = source->Length();
+    if (is_module) {
+#if V8_MAJOR_VERSION > 8
+        v8::ScriptOrigin origin(isolate, script_url, ln, col, true, -1, v8::Local<v8::Value>(), false, false, true);
+#else
+        v8::ScriptOrigin origin(script_url, v8::Integer::New(isolate, ln), v8::Integer::New(isolate, col), v8::True(isolate),
+            v8::Local<v8::Integer>(), v8::Local<v8::Value>(), v8::False(isolate), v8::False(isolate), v8::True(isolate));
+#endif
+        auto module = CompileString<v8::Module>(context, source, origin);
+
+        if (!module.IsEmpty()) {
+            cached_data = v8::ScriptCompiler::CreateCodeCache(module.ToLocalChecked()->GetUnboundModuleScript());
+        }
+    } else {
+#if V8_MAJOR_VERSION > 8
+        v8::ScriptOrigin origin(isolate, script_url, ln, col);
+#else
+        v8::ScriptOrigin origin(script_url, v8::Integer::New(isolate, ln), v8::Integer::New(isolate, col));
+#endif
+
+        auto script = CompileString<v8::Script>(context, source, origin);
+        if (!script.IsEmpty()) {
+            cached_data = v8::ScriptCompiler::CreateCodeCache(script.ToLocalChecked()->GetUnboundScript());
+        }
+    }
+    if (try_catch.HasCaught()) {
+        v8::Local<v8::Value> stack_trace;
+        if (try_catch.StackTrace(context).ToLocal(&stack_trace)) {
+            v8::String::Utf8Value info(isolate, stack_trace);
+            result.error = *info;
+        } else {
+            v8::String::Utf8Value info(isolate, try_catch.Exception());
+            result.error = *info;
+        }
+        delete cached_data;
+        return false;
+    }
+    if (!cached_data) {
+        result.error = "cached_data is nullptr!!!";
+        return false;
+    }
+
+    result.data.assign(cached_data->data, cached_data->data + cached_data->length);
+    delete cached_data;
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    return true;
+}
+
+bool isScriptFile(const std::string& filename) {
+    return endsWith(filename, ".js") || endsWith(filename, ".cjs") || endsWith(filename, ".mjs");
+}
+
+// 递归收集目录下的js文件，url为相对root的路径，统一用'/'分隔
+void collectDirectory(const std::string& root, const std::string& relative, std::vector<CompileJob>& jobs) {
+    std::string dir = relative.empty() ? root : root + "/" + relative;
+    std::vector<std::pair<std::string, bool>> children;
+#if defined(PLATFORM_WINDOWS)
+    WIN32_FIND_DATAA find_data;
+    HANDLE handle = FindFirstFileA((dir + "/*").c_str(), &find_data);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    do {
+        children.emplace_back(find_data.cFileName, (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0);
+    } while (FindNextFileA(handle, &find_data));
+    FindClose(handle);
+#else
+    DIR* d = opendir(dir.c_str());
+    if (!d) {
+        return;
+    }
+    while (dirent* entry = readdir(d)) {
+        struct stat st;
+        std::string name = entry->d_name;
+        if (stat((dir + "/" + name).c_str(), &st) == 0) {
+            children.emplace_back(name, S_ISDIR(st.st_mode));
+        }
+    }
+    closedir(d);
+#endif
+    std::sort(children.begin(), children.end());
+    for (auto& child : children) {
+        if (child.first == "." || child.first == "..") {
+            continue;
+        }
+        std::string child_relative = relative.empty() ? child.first : relative + "/" + child.first;
+        if (child.second) {
+            collectDirectory(root, child_relative, jobs);
+        } else if (isScriptFile(child.first)) {
+            CompileJob job;
+            job.filename = root + "/" + child_relative;
+            job.url = child_relative;
+            job.is_module = endsWith(child.first, ".mjs");
+            jobs.push_back(job);
+        }
+    }
+}
+
+// manifest每行一个文件，可选用tab分隔给出运行时url；空行和#开头的行忽略
+bool readManifest(const std::string& manifest, std::vector<CompileJob>& jobs) {
+    std::ifstream file(manifest);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        CompileJob job;
+        auto tab_pos = line.find('\t');
+        job.filename = line.substr(0, tab_pos);
+        job.url = tab_pos == std::string::npos ? job.filename : line.substr(tab_pos + 1);
+        job.is_module = endsWith(job.filename, ".mjs");
+        jobs.push_back(job);
+    }
+    return true;
+}
+
+// 每个worker一个isolate和context，从共享下标里取任务，直到取完
+void compileWorker(const std::vector<CompileJob>& jobs, std::vector<CompileResult>& results, std::atomic<size_t>& next,
+                   bool no_cjs_wrap, std::mutex& print_mutex) {
+    v8::Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    v8::Isolate* isolate = v8::Isolate::New(create_params);
+    {
+        v8::Isolate::Scope isolate_scope(isolate);
+        v8::HandleScope handle_scope(isolate);
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        v8::Context::Scope context_scope(context);
+
+        for (size_t i = next++; i < jobs.size(); i = next++) {
+            const CompileJob& job = jobs[i];
+            CompileResult& result = results[i];
+            std::string content;
+            if (!readFile(job.filename, content)) {
+                result.error = "Error opening file: " + job.filename;
+            } else {
+                compileCodeCache(isolate, context, content, job.url, job.is_module, no_cjs_wrap, 0, 0, result);
+            }
+
+            std::lock_guard<std::mutex> guard(print_mutex);
+            if (!result.error.empty()) {
+                std::cerr << "[" << (i + 1) << "/" << jobs.size() << "] failed: " << job.filename << std::endl << result.error << std::endl;
+            } else {
+                std::cout << "[" << (i + 1) << "/" << jobs.size() << "] " << result.elapsed_ms << " ms, source length: " << result.source_length
+                          << ", bytecode length: " << result.data.size() << ", " << job.filename << std::endl;
+            }
+        }
+    }
+    isolate->Dispose();
+    delete create_params.array_buffer_allocator;
+}
+
+bool writeBundle(const std::string& bundle_filename, const std::vector<CompileJob>& jobs, const std::vector<CompileResult>& results) {
+    std::vector<std::pair<puerts::FCodeCacheBundleEntry, size_t>> entries;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        puerts::FCodeCacheBundleEntry entry = {};
+        entry.PathHash = puerts::CodeCachePathHash(jobs[i].url.c_str(), jobs[i].url.size());
+        entry.Length = (uint32_t)results[i].data.size();
+        entry.SourceHash = ((const CodeCacheHeader*)results[i].data.data())->SourceHash;
+        entries.emplace_back(entry, i);
+    }
+    std::sort(entries.begin(), entries.end(), [](const std::pair<puerts::FCodeCacheBundleEntry, size_t>& a,
+                                                 const std::pair<puerts::FCodeCacheBundleEntry, size_t>& b) {
+        return a.first.PathHash < b.first.PathHash;
+    });
+    for (size_t i = 1; i < entries.size(); ++i) {
+        if (entries[i].first.PathHash == entries[i - 1].first.PathHash) {
+            std::cerr << "duplicate url (or hash collision) in bundle: " << jobs[entries[i - 1].second].url << " and "
+                      << jobs[entries[i].second].url << std::endl;
+            return false;
+        }
+    }
+
+    size_t offset = sizeof(puerts::FCodeCacheBundleHeader) + entries.size() * sizeof(puerts::FCodeCacheBundleEntry);
+    for (auto& entry : entries) {
+        offset = (offset + 7) & ~(size_t)7;
+        if (offset > UINT32_MAX) {
+            std::cerr << "bundle too large: " << bundle_filename << std::endl;
+            return false;
+        }
+        entry.first.Offset = (uint32_t)offset;
+        offset += entry.first.Length;
+    }
+
+    std::vector<uint8_t> bundle(offset, 0);
+    puerts::FCodeCacheBundleHeader header = {};
+    header.Magic = puerts::kCodeCacheBundleMagic;
+    header.Version = puerts::kCodeCacheBundleVersion;
+    header.EntryCount = (uint32_t)entries.size();
+    memcpy(bundle.data(), &header, sizeof(header));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        memcpy(bundle.data() + sizeof(header) + i * sizeof(puerts::FCodeCacheBundleEntry), &entries[i].first,
+               sizeof(puerts::FCodeCacheBundleEntry));
+        const std::vector<uint8_t>& data = results[entries[i].second].data;
+        memcpy(bundle.data() + entries[i].first.Offset, data.data(), data.size());
+    }
+    return writeFile(bundle_filename, bundle);
+}
+
+int runBatch(const std::string& input, int jobs_count, const std::string& bundle_filename, bool force_module, bool no_cjs_wrap,
+             bool verbose, const std::string& flags) {
+    std::vector<CompileJob> jobs;
+    struct stat st;
+    if (stat(input.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        std::string root = input;
+        while (root.size() > 1 && (root.back() == '/' || root.back() == '\\')) {
+            root.pop_back();
+        }
+        collectDirectory(root, "", jobs);
+    } else if (!readManifest(input, jobs)) {
+        std::cerr << "Error opening manifest: " << input << std::endl;
+        return 1;
+    }
+    if (jobs.empty()) {
+        std::cerr << "no source found in " << input << std::endl;
+        return 1;
+    }
+    if (force_module) {
+        for (auto& job : jobs) {
+            job.is_module = true;
+        }
+    }
+    if (jobs_count <= 0) {
+        jobs_count = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    jobs_count = std::min(jobs_count, (int)jobs.size());
+
+    v8::V8::SetFlagsFromString(flags.c_str(), flags.size());
+    std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
+    v8::V8::InitializePlatform(platform.get());
+    v8::V8::Initialize();
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<CompileResult> results(jobs.size());
+    std::atomic<size_t> next(0);
+    std::mutex print_mutex;
+    std::vector<std::thread> workers;
+    for (int i = 0; i < jobs_count; ++i) {
+        workers.emplace_back(compileWorker, std::cref(jobs), std::ref(results), std::ref(next), no_cjs_wrap, std::ref(print_mutex));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    v8::V8::Dispose();
+#if V8_MAJOR_VERSION > 9
+    v8::V8::DisposePlatform();
+#else
+    v8::V8::ShutdownPlatform();
+#endif
+
+    size_t failed = 0;
+    size_t total_bytes = 0;
+    double compile_ms = 0;
+    for (auto& result : results) {
+        if (!result.error.empty()) {
+            ++failed;
+        }
+        total_bytes += result.data.size();
+        compile_ms += result.elapsed_ms;
+    }
+
+    if (failed == 0) {
+        if (!bundle_filename.empty()) {
+            if (!writeBundle(bundle_filename, jobs, results)) {
+                std::cerr << "Error creating bundle: " << bundle_filename << std::endl;
+                return 1;
+            }
+        } else {
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                std::string output_filename = outputFilename(jobs[i].filename, jobs[i].is_module);
+                if (!writeFile(output_filename, results[i].data)) {
+                    std::cerr << "Error creating file: " << output_filename << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    std::cout << "files: " << jobs.size() << ", failed: " << failed << ", workers: " << jobs_count << ", wall: " << wall_ms
+              << " ms, compile: " << compile_ms << " ms, bytecode: " << total_bytes << " bytes" << std::endl;
+    if (verbose) {
+        std::cout << "cjs: " << !no_cjs_wrap << std::endl;
+        std::cout << "v8 flags: " << flags << std::endl;
+        if (!bundle_filename.empty()) {
+            std::cout << "bundle: " << bundle_filename << std::endl;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         std::cerr << "Usage: " << argv[0] << " <filename> [--module] [--no-cjs-wrap] [--verbose] [--url=<string>] [--ln=<number>] [--col=<number>] [v8_flag1] [v8_flag2] ..." << std::endl;
+        std::cerr << "       " << argv[0] << " --batch=<manifest|directory> [--jobs=<number>] [--bundle=<output>] [--module] [--no-cjs-wrap] [--verbose] [v8_flag1] [v8_flag2] ..." << std::endl;
+        std::cerr << "       manifest: one source per line, optionally followed by <tab><url>; directory: all .js/.cjs/.mjs, url relative to it" << std::endl;
         return 1;
     }
 
     std::string filename = argv[1];
+    std::string batch_input;
+    if (filename.rfind("--batch=", 0) == 0) {
+        batch_input = filename.substr(8);
+    }
     bool is_module = endsWith(filename, ".mjs");
+    bool force_module = false;
     bool no_cjs_wrap = false;
     bool verbose = false;
     std::string flags = "--no-lazy --no-flush-bytecode --no-enable-lazy-source-positions";
     std::string url = filename;
     int ln = 0;
     int col = 0;
+    bool has_origin_args = false;
+    int jobs_count = 0;
+    std::string bundle_filename;
     if (argc > 2) {
         for (int i = 2; i < argc; ++i) {
             std::string arg = argv[i];
             if (arg == "--module") {
                 is_module = true;
+                force_module = true;
                 continue;
             }
             if (arg == "--no-cjs-wrap") {
@@ -81,36 +456,49 @@ int main(int argc, char* argv[]) {
             }
             if (arg.rfind("--url=", 0) == 0) {
                 url = arg.substr(6);
+                has_origin_args = true;
                 continue;
             }
             if (arg.rfind("--ln=", 0) == 0) {
                 ln = std::stoi(arg.substr(5));
+                has_origin_args = true;
                 continue;
             }
             if (arg.rfind("--col=", 0) == 0) {
                 col = std::stoi(arg.substr(6));
+                has_origin_args = true;
+                continue;
+            }
+            if (!batch_input.empty() && arg.rfind("--jobs=", 0) == 0) {
+                jobs_count = std::stoi(arg.substr(7));
+                continue;
+            }
+            if (!batch_input.empty() && arg.rfind("--bundle=", 0) == 0) {
+                bundle_filename = arg.substr(9);
                 continue;
             }
             flags += (" " + arg);
         }
     }
-    
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+
+    if (!batch_input.empty()) {
+        // 批量模式下每个文件的url来自manifest或者相对目录的路径，单个文件的origin参数没有意义
+        if (has_origin_args) {
+            std::cerr << "--url/--ln/--col can not be used with --batch, put urls in the manifest instead" << std::endl;
+            return 1;
+        }
+        return runBatch(batch_input, jobs_count, bundle_filename, force_module, no_cjs_wrap, verbose, flags);
+    }
+
+    std::string fileContent;
+    if (!readFile(filename, fileContent)) {
         std::cerr << "Error opening file: " << filename << std::endl;
         return 1;
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-
-    std::string fileContent = buffer.str();
-    
     v8::V8::SetFlagsFromString(flags.c_str(), flags.size());
-    
-    file.close();
-    
-    v8::ScriptCompiler::CachedData* cached_data = nullptr;
+
+    CompileResult result;
     // --- begin get code cache ---
     std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
     v8::V8::InitializePlatform(platform.get());
@@ -121,53 +509,13 @@ int main(int argc, char* argv[]) {
     create_params.array_buffer_allocator =
         v8::ArrayBuffer::Allocator::NewDefaultAllocator();
     v8::Isolate* isolate = v8::Isolate::New(create_params);
-    int source_length = 0;
+    bool success = false;
     {
         v8::Isolate::Scope isolate_scope(isolate);
         v8::HandleScope handle_scope(isolate);
         v8::Local<v8::Context> context = v8::Context::New(isolate);
         v8::Context::Scope context_scope(context);
-        v8::TryCatch try_catch(isolate);
-        auto script_url = v8::String::NewFromUtf8(isolate, url.c_str()).ToLocalChecked();
-        if (!is_module && !no_cjs_wrap) {
-            fileContent = "(function (exports, require, module, __filename, __dirname) { " + fileContent + "\n});";
-        }
-        v8::Local<v8::String> source =
-            v8::String::NewFromUtf8(isolate, fileContent.c_str()).ToLocalChecked();
-        source_length = source->Length();
-        if (is_module) {
-#if V8_MAJOR_VERSION > 8
-            v8::ScriptOrigin origin(isolate, script_url, ln, col, true, -1, v8::Local<v8::Value>(), false, false, true);
-#else
-            v8::ScriptOrigin origin(script_url, v8::Integer::New(isolate, ln), v8::Integer::New(isolate, col), v8::True(isolate),
-                v8::Local<v8::Integer>(), v8::Local<v8::Value>(), v8::False(isolate), v8::False(isolate), v8::True(isolate));
-#endif
-            auto module = CompileString<v8::Module>(context, source, origin);
-            
-            if (!module.IsEmpty()) {
-                cached_data = v8::ScriptCompiler::CreateCodeCache(module.ToLocalChecked()->GetUnboundModuleScript());
-            }
-        } else {
-#if V8_MAJOR_VERSION > 8
-            v8::ScriptOrigin origin(isolate, script_url, ln, col);
-#else
-            v8::ScriptOrigin origin(script_url, v8::Integer::New(isolate, ln), v8::Integer::New(isolate, col));
-#endif
-            
-            auto script = CompileString<v8::Script>(context, source, origin);
-            if (!script.IsEmpty()) {
-                cached_data = v8::ScriptCompiler::CreateCodeCache(script.ToLocalChecked()->GetUnboundScript());
-            }
-        }
-        if (try_catch.HasCaught()) {
-            v8::Local<v8::Value> stack_trace;
-            if (try_catch.StackTrace(context).ToLocal(&stack_trace))
-            {
-                v8::String::Utf8Value info(isolate, stack_trace);
-                std::cout << (*info) << std::endl;
-            }
-            return 1;
-        }
+        success = compileCodeCache(isolate, context, fileContent, url, is_module, no_cjs_wrap, ln, col, result);
     }
 
     // Dispose the isolate and tear down V8.
@@ -180,36 +528,32 @@ int main(int argc, char* argv[]) {
 #endif
     delete create_params.array_buffer_allocator;
     // --- end get code cache ---
-    
-    if (!cached_data) {
-        std::cout << "cached_data is nullptr!!!" << std::endl;
+
+    if (!success) {
+        std::cout << result.error << std::endl;
+        return 1;
     }
-    
-    auto dot_pos = filename.find_last_of('.');
-    std::string output_filename = filename.substr(0, dot_pos == std::string::npos ? filename.size(): dot_pos) + (is_module ? ".mbc" : ".cbc");
-    
-    std::ofstream output_file(output_filename, std::ios::binary);
-    if (!output_file.is_open()) {
+
+    std::string output_filename = outputFilename(filename, is_module);
+    if (!writeFile(output_filename, result.data)) {
         std::cerr << "Error creating file: " << output_filename << std::endl;
         return 1;
     }
-    
-    output_file.write((const char*)cached_data->data, cached_data->length);
-    output_file.close();
-    
+
     if (verbose) {
         std::cout << "esm: " << is_module << std::endl;
         std::cout << "cjs: " << (!is_module && !no_cjs_wrap) << std::endl;
         std::cout << "v8 flags: " << flags << std::endl;
-        
+
         //std::cout << fileContent << std::endl;
-        std::cout << "input : " << filename << ", source length: " << source_length << std::endl;
-        std::cout << "output: " << output_filename << ", bytecode length: " << cached_data->length << std::endl;
+        std::cout << "input : " << filename << ", source length: " << result.source_length << std::endl;
+        std::cout << "output: " << output_filename << ", bytecode length: " << result.data.size() << std::endl;
         std::cout << "url: " << url << std::endl;
         std::cout << "line offset: " << ln << std::endl;
         std::cout << "column offset: " << col << std::endl;
-        
-        const CodeCacheHeader *cch = (const CodeCacheHeader *)cached_data->data;
+        std::cout << "compile time: " << result.elapsed_ms << " ms" << std::endl;
+
+        const CodeCacheHeader *cch = (const CodeCacheHeader *)result.data.data();
         std::cout << "MagicNumber : " << cch->MagicNumber << std::endl;
         std::cout << "VersionHash : " << cch->VersionHash << std::endl;
         std::cout << "SourceHash : " << cch->SourceHash << std::endl;
@@ -217,8 +561,6 @@ int main(int argc, char* argv[]) {
         std::cout << "PayloadLength : " << cch->PayloadLength << std::endl;
         std::cout << "Checksum : " << cch->Checksum << std::endl;
     }
-    
-    delete cached_data;
-    
+
     return 0;
-}
\ No newline at end of file
+}
@@ -50,11 +50,34 @@ var global = global || (function () { return this; }());
     
     const readyStates = ['CONNECTING', 'OPEN', 'CLOSING', 'CLOSED'];
     
+    // WebSocket.useSharedIo为true时创建的socket共用native的网络线程，所有socket的消息每tick统一派发一次
+    const sharedSockets = new Set();
+    let sharedTid;
+    
+    function pollShared() {
+        WebSocketPP.dispatch();
+        for (const ws of sharedSockets) {
+            ws._flush();
+        }
+        if (sharedSockets.size === 0) {
+            clearInterval(sharedTid);
+            sharedTid = undefined;
+        }
+    }
+    
+    function addSharedSocket(ws) {
+        sharedSockets.add(ws);
+        if (sharedTid === undefined) {
+            sharedTid = setInterval(pollShared, 1);
+        }
+    }
+    
     class WebSocket extends EventTarget {
         constructor(url, protocols) {
             super();
             if (protocols) throw new Error('do not support protocols argument');
-            this._raw = new WebSocketPP(url);
+            this._shared = !!WebSocket.useSharedIo;
+            this._raw = new WebSocketPP(url, this._shared);
             this._url = url;
             // !!do not raise exception in handles.
             this._raw.setHandles(
@@ -74,8 +97,12 @@ var global = global || (function () { return this; }());
             });
             
             this._readyState = WebSocket.CONNECTING;
-            this._tid = setInterval(() => this._poll(), 1);
             this._pendingEvents = [];
+            if (this._shared) {
+                addSharedSocket(this);
+            } else {
+                this._tid = setInterval(() => this._poll(), 1);
+            }
         }
         
         get url() {
@@ -127,6 +154,21 @@ var global = global || (function () { return this; }());
             }
         }
         
+        // 共享模式下由pollShared调用，一次派发完所有待处理事件
+        _flush() {
+            let ev;
+            while ((ev = this._pendingEvents.shift())) {
+                this.dispatchEvent(ev);
+                if (ev.type === 'close') break;
+            }
+            if (this._readyState == WebSocket.CLOSING || (ev && ev.type === 'close')) {
+                this._raw = undefined;
+                sharedSockets.delete(this);
+                this._readyState = WebSocket.CLOSED;
+                this._pendingEvents = [];
+            }
+        }
+        
         close(code, data) {
             try {
                 this._raw.close(code, data);
@@ -148,6 +190,8 @@ var global = global || (function () { return this; }());
         });
     }
     
+    WebSocket.useSharedIo = false;
+    
     global.WebSocket = WebSocket;
 
 }(global));
\ No newline at end of file
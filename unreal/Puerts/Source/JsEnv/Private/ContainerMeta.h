@@ -51,6 +51,20 @@ public:
 
     void NotifyElementTypeDeleted(const UField* Struct);
 
+    int32 NumElementTypes() const
+    {
+        return ObjectPropertyMap.Num();
+    }
+
+    template <typename TFunc>
+    void ForEachElementType(TFunc&& Func) const
+    {
+        for (auto& KV : ObjectPropertyMap)
+        {
+            Func(KV.Key);
+        }
+    }
+
 private:
     UScriptStruct* PropertyMetaRoot;
 
@@ -11,11 +11,167 @@
 
 namespace PUERTS_NAMESPACE
 {
+// View缓存的ArrayBuffer所在的internal field
+static const int ARRAY_VIEW_FIELD = 4;
+
+enum class ETypedViewKind : uint8
+{
+    None,
+    Int8,
+    Uint8,
+    Int16,
+    Uint16,
+    Int32,
+    Uint32,
+    Float32,
+    Float64,
+    BigInt64,
+    BigUint64
+};
+
+static ETypedViewKind GetNumericViewKind(const PropertyMacro* Property)
+{
+    if (Property->IsA<FloatPropertyMacro>())
+        return ETypedViewKind::Float32;
+    if (Property->IsA<DoublePropertyMacro>())
+        return ETypedViewKind::Float64;
+    if (Property->IsA<IntPropertyMacro>())
+        return ETypedViewKind::Int32;
+    if (Property->IsA<UInt32PropertyMacro>())
+        return ETypedViewKind::Uint32;
+    if (Property->IsA<BytePropertyMacro>())
+        return ETypedViewKind::Uint8;
+    if (Property->IsA<Int8PropertyMacro>())
+        return ETypedViewKind::Int8;
+    if (Property->IsA<Int16PropertyMacro>())
+        return ETypedViewKind::Int16;
+    if (Property->IsA<UInt16PropertyMacro>())
+        return ETypedViewKind::Uint16;
+    if (Property->IsA<Int64PropertyMacro>())
+        return ETypedViewKind::BigInt64;
+    if (Property->IsA<UInt64PropertyMacro>())
+        return ETypedViewKind::BigUint64;
+    return ETypedViewKind::None;
+}
+
+// 元素能否按TypedArray整体访问：数值类型，或者只包含同一种数值类型、中间没有填充的结构体(FVector、FLinearColor、FIntPoint等)
+static ETypedViewKind GetTypedViewKind(PropertyMacro* Property)
+{
+    if (Property->ArrayDim != 1)
+    {
+        return ETypedViewKind::None;
+    }
+    ETypedViewKind Kind = GetNumericViewKind(Property);
+    if (Kind != ETypedViewKind::None)
+    {
+        return Kind;
+    }
+    const StructPropertyMacro* StructProperty = CastFieldMacro<StructPropertyMacro>(Property);
+    if (!StructProperty || !StructProperty->Struct)
+    {
+        return ETypedViewKind::None;
+    }
+    int32 ExpectOffset = 0;
+    for (TFieldIterator<PropertyMacro> It(StructProperty->Struct); It; ++It)
+    {
+        ETypedViewKind FieldKind = GetNumericViewKind(*It);
+        if (FieldKind == ETypedViewKind::None || (Kind != ETypedViewKind::None && FieldKind != Kind) ||
+            It->GetOffset_ForInternal() != ExpectOffset)
+        {
+            return ETypedViewKind::None;
+        }
+        Kind = FieldKind;
+        ExpectOffset += It->GetSize();
+    }
+    return ExpectOffset == GetSizeWithAlignment(Property) ? Kind : ETypedViewKind::None;
+}
+
+static size_t GetTypedViewScalarSize(ETypedViewKind Kind)
+{
+    switch (Kind)
+    {
+        case ETypedViewKind::Int8:
+        case ETypedViewKind::Uint8:
+            return 1;
+        case ETypedViewKind::Int16:
+        case ETypedViewKind::Uint16:
+            return 2;
+        case ETypedViewKind::Int32:
+        case ETypedViewKind::Uint32:
+        case ETypedViewKind::Float32:
+            return 4;
+        default:
+            return 8;
+    }
+}
+
+#if !defined(WITH_QUICKJS)
+static v8::Local<v8::Value> NewTypedArray(v8::Local<v8::ArrayBuffer> Buffer, ETypedViewKind Kind, size_t ByteLength)
+{
+    const size_t Length = ByteLength / GetTypedViewScalarSize(Kind);
+    switch (Kind)
+    {
+        case ETypedViewKind::Int8:
+            return v8::Int8Array::New(Buffer, 0, Length);
+        case ETypedViewKind::Uint8:
+            return v8::Uint8Array::New(Buffer, 0, Length);
+        case ETypedViewKind::Int16:
+            return v8::Int16Array::New(Buffer, 0, Length);
+        case ETypedViewKind::Uint16:
+            return v8::Uint16Array::New(Buffer, 0, Length);
+        case ETypedViewKind::Int32:
+            return v8::Int32Array::New(Buffer, 0, Length);
+        case ETypedViewKind::Uint32:
+            return v8::Uint32Array::New(Buffer, 0, Length);
+        case ETypedViewKind::Float32:
+            return v8::Float32Array::New(Buffer, 0, Length);
+        case ETypedViewKind::Float64:
+            return v8::Float64Array::New(Buffer, 0, Length);
+        case ETypedViewKind::BigInt64:
+            return v8::BigInt64Array::New(Buffer, 0, Length);
+        default:
+            return v8::BigUint64Array::New(Buffer, 0, Length);
+    }
+}
+
+// Uint8ClampedArray内存布局和Uint8Array一致，按Uint8处理；DataView等不是TypedArray的返回None
+static ETypedViewKind GetTypedArrayKind(v8::Local<v8::Value> Value)
+{
+    if (Value->IsInt8Array())
+        return ETypedViewKind::Int8;
+    if (Value->IsUint8Array() || Value->IsUint8ClampedArray())
+        return ETypedViewKind::Uint8;
+    if (Value->IsInt16Array())
+        return ETypedViewKind::Int16;
+    if (Value->IsUint16Array())
+        return ETypedViewKind::Uint16;
+    if (Value->IsInt32Array())
+        return ETypedViewKind::Int32;
+    if (Value->IsUint32Array())
+        return ETypedViewKind::Uint32;
+    if (Value->IsFloat32Array())
+        return ETypedViewKind::Float32;
+    if (Value->IsFloat64Array())
+        return ETypedViewKind::Float64;
+    if (Value->IsBigInt64Array())
+        return ETypedViewKind::BigInt64;
+    if (Value->IsBigUint64Array())
+        return ETypedViewKind::BigUint64;
+    return ETypedViewKind::None;
+}
+
+// view的ArrayBuffer通过这个private key引用容器的js对象，不会像普通属性那样暴露给js
+static v8::Local<v8::Private> ViewOwnerKey(v8::Isolate* Isolate)
+{
+    return v8::Private::ForApi(Isolate, FV8Utils::InternalString(Isolate, "__puerts_array_view_owner"));
+}
+#endif
+
 v8::Local<v8::FunctionTemplate> FScriptArrayWrapper::ToFunctionTemplate(v8::Isolate* Isolate)
 {
     v8::Isolate::Scope Isolatescope(Isolate);
     auto Result = v8::FunctionTemplate::New(Isolate, New);
-    Result->InstanceTemplate()->SetInternalFieldCount(4);    // 0 Ptr, 1 Property
+    Result->InstanceTemplate()->SetInternalFieldCount(5);    // 0 Ptr, 1 Property, 4 View
 
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Num"), v8::FunctionTemplate::New(Isolate, Num));
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Add"), v8::FunctionTemplate::New(Isolate, Add));
@@ -28,6 +184,13 @@ v8::Local<v8::FunctionTemplate> FScriptArrayWrapper::ToFunctionTemplate(v8::Isol
     Result->PrototypeTemplate()->Set(
         FV8Utils::InternalString(Isolate, "IsValidIndex"), v8::FunctionTemplate::New(Isolate, IsValidIndex));
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Empty"), v8::FunctionTemplate::New(Isolate, Empty));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "View"), v8::FunctionTemplate::New(Isolate, View));
+    Result->PrototypeTemplate()->Set(
+        FV8Utils::InternalString(Isolate, "IsViewValid"), v8::FunctionTemplate::New(Isolate, IsViewValid));
+    Result->PrototypeTemplate()->Set(
+        FV8Utils::InternalString(Isolate, "ToTypedArray"), v8::FunctionTemplate::New(Isolate, ToTypedArray));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "CopyFrom"), v8::FunctionTemplate::New(Isolate, CopyFrom));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "ToArray"), v8::FunctionTemplate::New(Isolate, ToArray));
 
     return Result;
 }
@@ -55,6 +218,7 @@ void FScriptArrayWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
             Inner->Property->InitializeValue(DataPtr);    //使用之前必须得初始化，即使是设置也要
             Inner->JsToUE(Isolate, Context, Info[i], DataPtr, false);
         }
+        ReleaseStaleView(Isolate, Info.Holder(), Self, GetSizeWithAlignment(Inner->Property));
         Info.GetReturnValue().Set(Index);
     }
 }
@@ -171,6 +335,7 @@ void FScriptArrayWrapper::RemoveAt(const v8::FunctionCallbackInfo<v8::Value>& In
 #else
         Self->Remove(Index, 1, GetSizeWithAlignment(Inner->Property));
 #endif
+        ReleaseStaleView(Isolate, Info.Holder(), Self, GetSizeWithAlignment(Inner->Property));
     }
 }
 
@@ -202,6 +367,242 @@ void FScriptArrayWrapper::Empty(const v8::FunctionCallbackInfo<v8::Value>& Info)
     }
 
     FScriptArrayEx::Empty(Self, Inner->Property);
+    ReleaseStaleView(Isolate, Info.Holder(), Self, GetSizeWithAlignment(Inner->Property));
+}
+
+void FScriptArrayWrapper::ReleaseStaleView(
+    v8::Isolate* Isolate, v8::Local<v8::Object> Holder, FScriptArray* ScriptArray, int32 ElementSize)
+{
+#if !defined(WITH_QUICKJS)
+    if (Holder->InternalFieldCount() <= ARRAY_VIEW_FIELD)
+    {
+        return;
+    }
+    v8::Local<v8::Value> Cached = Holder->GetInternalField(ARRAY_VIEW_FIELD).As<v8::Value>();
+    if (!Cached->IsArrayBuffer())
+    {
+        return;
+    }
+    v8::Local<v8::ArrayBuffer> Buffer = Cached.As<v8::ArrayBuffer>();
+    size_t ByteLength;
+    void* Data = DataTransfer::GetArrayBufferData(Buffer, ByteLength);
+    if (Data != ScriptArray->GetData() || ByteLength != static_cast<size_t>(ScriptArray->Num()) * ElementSize)
+    {
+        Buffer->Detach();
+        Holder->SetInternalField(ARRAY_VIEW_FIELD, v8::Undefined(Isolate));
+    }
+#endif
+}
+
+void FScriptArrayWrapper::View(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+#if defined(WITH_QUICKJS)
+    FV8Utils::ThrowException(Isolate, "View is not supported in quickjs backend, use ToTypedArray");
+#else
+    auto Self = FV8Utils::GetPointerFast<FScriptArray>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+    ETypedViewKind Kind = GetTypedViewKind(Inner->Property);
+    if (Kind == ETypedViewKind::None)
+    {
+        FV8Utils::ThrowException(Isolate, "element type can not be viewed as a typed array");
+        return;
+    }
+    const int32 ElementSize = GetSizeWithAlignment(Inner->Property);
+    const size_t ByteLength = static_cast<size_t>(Self->Num()) * ElementSize;
+
+    ReleaseStaleView(Isolate, Info.Holder(), Self, ElementSize);
+    v8::Local<v8::Value> Cached = Info.Holder()->GetInternalField(ARRAY_VIEW_FIELD).As<v8::Value>();
+    v8::Local<v8::ArrayBuffer> Buffer;
+    if (Cached->IsArrayBuffer())
+    {
+        Buffer = Cached.As<v8::ArrayBuffer>();
+    }
+    else
+    {
+        Buffer = DataTransfer::NewArrayBuffer(Context, Self->GetData(), ByteLength);
+        // view存活期间容器的js对象不能被回收，否则FScriptArrayEx会被释放
+        (void) Buffer->SetPrivate(Context, ViewOwnerKey(Isolate), Info.Holder());
+        Info.Holder()->SetInternalField(ARRAY_VIEW_FIELD, Buffer);
+    }
+    Info.GetReturnValue().Set(NewTypedArray(Buffer, Kind, ByteLength));
+#endif
+}
+
+void FScriptArrayWrapper::IsViewValid(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+
+    CHECK_V8_ARGS_LEN(1);
+
+    bool Result = false;
+#if !defined(WITH_QUICKJS)
+    auto Self = FV8Utils::GetPointerFast<FScriptArray>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (Info[0]->IsArrayBufferView() && Inner->IsPropertyValid())
+    {
+        ReleaseStaleView(Isolate, Info.Holder(), Self, GetSizeWithAlignment(Inner->Property));
+        v8::Local<v8::Value> Cached = Info.Holder()->GetInternalField(ARRAY_VIEW_FIELD).As<v8::Value>();
+        Result = Cached->IsArrayBuffer() && Info[0].As<v8::ArrayBufferView>()->Buffer() == Cached.As<v8::ArrayBuffer>();
+    }
+#endif
+    Info.GetReturnValue().Set(Result);
+}
+
+void FScriptArrayWrapper::ToTypedArray(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptArray>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+    ETypedViewKind Kind = GetTypedViewKind(Inner->Property);
+    if (Kind == ETypedViewKind::None)
+    {
+        FV8Utils::ThrowException(Isolate, "element type can not be copied to a typed array");
+        return;
+    }
+    const size_t ByteLength = static_cast<size_t>(Self->Num()) * GetSizeWithAlignment(Inner->Property);
+    v8::Local<v8::ArrayBuffer> Buffer = v8::ArrayBuffer::New(Isolate, ByteLength);
+    if (ByteLength > 0)
+    {
+        FMemory::Memcpy(DataTransfer::GetArrayBufferData(Buffer), Self->GetData(), ByteLength);
+    }
+#if defined(WITH_QUICKJS)
+    // quickjs后端没有各类TypedArray的构造接口，直接返回ArrayBuffer，由js侧按需要的类型包装
+    Info.GetReturnValue().Set(Buffer);
+#else
+    Info.GetReturnValue().Set(NewTypedArray(Buffer, Kind, ByteLength));
+#endif
+}
+
+void FScriptArrayWrapper::CopyFrom(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+
+    CHECK_V8_ARGS_LEN(1);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptArray>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+    ETypedViewKind Kind = GetTypedViewKind(Inner->Property);
+    if (Kind == ETypedViewKind::None)
+    {
+        FV8Utils::ThrowException(Isolate, "element type can not be copied from a typed array");
+        return;
+    }
+
+    // TypedArray的元素类型必须和容器元素一致；ArrayBuffer和DataView没有元素类型，按字节原样拷贝
+    const uint8* Source = nullptr;
+    size_t ByteLength = 0;
+    if (Info[0]->IsArrayBuffer())
+    {
+        Source = static_cast<const uint8*>(DataTransfer::GetArrayBufferData(Info[0].As<v8::ArrayBuffer>(), ByteLength));
+    }
+#if !defined(WITH_QUICKJS)
+    else if (Info[0]->IsArrayBufferView())
+    {
+        if (!Info[0]->IsDataView() && GetTypedArrayKind(Info[0]) != Kind)
+        {
+            FV8Utils::ThrowException(Isolate, "typed array element type does not match the container element type");
+            return;
+        }
+        v8::Local<v8::ArrayBufferView> SourceView = Info[0].As<v8::ArrayBufferView>();
+        Source = static_cast<const uint8*>(DataTransfer::GetArrayBufferData(SourceView->Buffer())) + SourceView->ByteOffset();
+        ByteLength = SourceView->ByteLength();
+    }
+#endif
+    else
+    {
+#if defined(WITH_QUICKJS)
+        FV8Utils::ThrowException(Isolate, "expect an ArrayBuffer");
+#else
+        FV8Utils::ThrowException(Isolate, "expect a typed array, a DataView or an ArrayBuffer");
+#endif
+        return;
+    }
+
+    const int32 ElementSize = GetSizeWithAlignment(Inner->Property);
+    if (ByteLength % ElementSize != 0 || ByteLength / ElementSize > static_cast<size_t>(MAX_int32))
+    {
+        FV8Utils::ThrowException(Isolate, "data length is not a multiple of element size");
+        return;
+    }
+    const int32 Count = static_cast<int32>(ByteLength / ElementSize);
+    AssignBytes(Self, ElementSize, Source, Count);
+    ReleaseStaleView(Isolate, Info.Holder(), Self, ElementSize);
+    Info.GetReturnValue().Set(Count);
+}
+
+void FScriptArrayWrapper::AssignBytes(FScriptArray* ScriptArray, int32 ElementSize, const uint8* Source, int32 Count)
+{
+    const int32 Num = ScriptArray->Num();
+    const size_t ByteLength = static_cast<size_t>(Count) * ElementSize;
+    if (Count > Num)
+    {
+        // 源数据比容器当前内存大，不可能是本容器的view，扩容后再拷贝
+        AddUninitialized(ScriptArray, ElementSize, Count - Num);
+        FMemory::Memcpy(ScriptArray->GetData(), Source, ByteLength);
+        return;
+    }
+
+    // 源数据可能是本容器的view(如arr.View().subarray(...))，Remove缩容时可能重新分配内存，
+    // 所以必须在Remove之前拷贝，重叠部分用memmove
+    if (ByteLength > 0)
+    {
+        FMemory::Memmove(ScriptArray->GetData(), Source, ByteLength);
+    }
+    if (Count < Num)
+    {
+#if ENGINE_MAJOR_VERSION > 4
+        ScriptArray->Remove(Count, Num - Count, ElementSize, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+#else
+        ScriptArray->Remove(Count, Num - Count, ElementSize);
+#endif
+    }
+}
+
+void FScriptArrayWrapper::ToArray(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    auto Self = FV8Utils::GetPointerFast<FScriptArray>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+
+    const int32 Num = Self->Num();
+    const int32 ElementSize = GetSizeWithAlignment(Inner->Property);
+    v8::Local<v8::Array> Result = v8::Array::New(Isolate, Num);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        (void) Result->Set(Context, i, Inner->UEToJs(Isolate, Context, GetData(Self, ElementSize, i), false));
+    }
+    Info.GetReturnValue().Set(Result);
 }
 
 FORCEINLINE int32 FScriptArrayWrapper::AddUninitialized(FScriptArray* ScriptArray, int32 ElementSize, int32 Count)
@@ -283,6 +684,8 @@ v8::Local<v8::FunctionTemplate> FScriptSetWrapper::ToFunctionTemplate(v8::Isolat
     Result->PrototypeTemplate()->Set(
         FV8Utils::InternalString(Isolate, "IsValidIndex"), v8::FunctionTemplate::New(Isolate, IsValidIndex));
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Empty"), v8::FunctionTemplate::New(Isolate, Empty));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "AddRange"), v8::FunctionTemplate::New(Isolate, AddRange));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "ToArray"), v8::FunctionTemplate::New(Isolate, ToArray));
 
     return Result;
 }
@@ -302,11 +705,82 @@ void FScriptSetWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
         FV8Utils::ThrowException(Isolate, "item info is invalid!");
         return;
     }
+
+    AddElement(Isolate, Context, Self, Inner, Info[0]);
+}
+
+void FScriptSetWrapper::AddRange(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS_LEN(1);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptSet>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+    if (!Info[0]->IsArray())
+    {
+        FV8Utils::ThrowException(Isolate, "expect an array");
+        return;
+    }
+
+    v8::Local<v8::Array> Values = Info[0].As<v8::Array>();
+    const uint32_t Length = Values->Length();
+    for (uint32_t i = 0; i < Length; ++i)
+    {
+        v8::Local<v8::Value> Value;
+        if (!Values->Get(Context, i).ToLocal(&Value))
+        {
+            return;
+        }
+        AddElement(Isolate, Context, Self, Inner, Value);
+    }
+}
+
+void FScriptSetWrapper::ToArray(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    auto Self = FV8Utils::GetPointerFast<FScriptSet>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+    auto Property = Inner->Property;
+
+    auto ScriptLayout = FScriptSet::GetScriptLayout(Property->GetSize(), Property->GetMinAlignment());
+    v8::Local<v8::Array> Result = v8::Array::New(Isolate, Self->Num());
+    const int32 MaxIndex = Self->GetMaxIndex();
+    uint32_t Count = 0;
+    for (int32 i = 0; i < MaxIndex; ++i)
+    {
+        if (Self->IsValidIndex(i))
+        {
+            (void) Result->Set(Context, Count++, Inner->UEToJs(Isolate, Context, Self->GetData(i, ScriptLayout), false));
+        }
+    }
+    Info.GetReturnValue().Set(Result);
+}
+
+void FScriptSetWrapper::AddElement(v8::Isolate* Isolate, v8::Local<v8::Context>& Context, FScriptSet* ScriptSet,
+    FPropertyTranslator* Inner, v8::Local<v8::Value> Value)
+{
+    auto Self = ScriptSet;
     auto Property = Inner->Property;
 
     void* DataPtr = FMemory_Alloca(GetSizeWithAlignment(Property));
     Property->InitializeValue(DataPtr);
-    Inner->JsToUE(Isolate, Context, Info[0], DataPtr, false);
+    Inner->JsToUE(Isolate, Context, Value, DataPtr, false);
 
     auto ScriptLayout = FScriptSet::GetScriptLayout(Property->GetSize(), Property->GetMinAlignment());
     Self->Add(
@@ -501,6 +975,8 @@ v8::Local<v8::FunctionTemplate> FScriptMapWrapper::ToFunctionTemplate(v8::Isolat
         FV8Utils::InternalString(Isolate, "IsValidIndex"), v8::FunctionTemplate::New(Isolate, IsValidIndex));
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "GetKey"), v8::FunctionTemplate::New(Isolate, GetKey));
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Empty"), v8::FunctionTemplate::New(Isolate, Empty));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "AddRange"), v8::FunctionTemplate::New(Isolate, AddRange));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "ToArray"), v8::FunctionTemplate::New(Isolate, ToArray));
 
     return Result;
 }
@@ -515,23 +991,107 @@ void FScriptMapWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
 
     auto Self = FV8Utils::GetPointerFast<FScriptMap>(Info.Holder(), 0);
     auto KeyPropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
-    auto KeyProperty = KeyPropertyTranslator->Property;
     auto ValuePropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 2);
-    auto ValueProperty = ValuePropertyTranslator->Property;
     if (!KeyPropertyTranslator->IsPropertyValid() || !ValuePropertyTranslator->IsPropertyValid())
     {
         FV8Utils::ThrowException(Isolate, "key/value info is invalid!");
         return;
     }
 
+    AddElement(Isolate, Context, Self, KeyPropertyTranslator, ValuePropertyTranslator, Info[0], Info[1]);
+}
+
+void FScriptMapWrapper::AddRange(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS_LEN(2);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptMap>(Info.Holder(), 0);
+    auto KeyPropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    auto ValuePropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 2);
+    if (!KeyPropertyTranslator->IsPropertyValid() || !ValuePropertyTranslator->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "key/value info is invalid!");
+        return;
+    }
+    if (!Info[0]->IsArray() || !Info[1]->IsArray() || Info[0].As<v8::Array>()->Length() != Info[1].As<v8::Array>()->Length())
+    {
+        FV8Utils::ThrowException(Isolate, "expect two arrays with the same length");
+        return;
+    }
+
+    v8::Local<v8::Array> Keys = Info[0].As<v8::Array>();
+    v8::Local<v8::Array> Values = Info[1].As<v8::Array>();
+    const uint32_t Length = Keys->Length();
+    for (uint32_t i = 0; i < Length; ++i)
+    {
+        v8::Local<v8::Value> Key;
+        v8::Local<v8::Value> Value;
+        if (!Keys->Get(Context, i).ToLocal(&Key) || !Values->Get(Context, i).ToLocal(&Value))
+        {
+            return;
+        }
+        AddElement(Isolate, Context, Self, KeyPropertyTranslator, ValuePropertyTranslator, Key, Value);
+    }
+}
+
+void FScriptMapWrapper::ToArray(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    auto Self = FV8Utils::GetPointerFast<FScriptMap>(Info.Holder(), 0);
+    auto KeyPropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    auto ValuePropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 2);
+    if (!KeyPropertyTranslator->IsPropertyValid() || !ValuePropertyTranslator->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "key/value info is invalid!");
+        return;
+    }
+
+    auto ScriptLayout = GetScriptLayout(KeyPropertyTranslator->Property, ValuePropertyTranslator->Property);
+    v8::Local<v8::Array> Keys = v8::Array::New(Isolate, Self->Num());
+    v8::Local<v8::Array> Values = v8::Array::New(Isolate, Self->Num());
+    const int32 MaxIndex = Self->GetMaxIndex();
+    uint32_t Count = 0;
+    for (int32 i = 0; i < MaxIndex; ++i)
+    {
+        if (Self->IsValidIndex(i))
+        {
+            uint8* Data = reinterpret_cast<uint8*>(Self->GetData(i, ScriptLayout));
+            (void) Keys->Set(
+                Context, Count, KeyPropertyTranslator->UEToJs(Isolate, Context, Data + GetKeyOffset(ScriptLayout), false));
+            (void) Values->Set(
+                Context, Count, ValuePropertyTranslator->UEToJs(Isolate, Context, Data + ScriptLayout.ValueOffset, false));
+            ++Count;
+        }
+    }
+    v8::Local<v8::Array> Result = v8::Array::New(Isolate, 2);
+    (void) Result->Set(Context, 0, Keys);
+    (void) Result->Set(Context, 1, Values);
+    Info.GetReturnValue().Set(Result);
+}
+
+void FScriptMapWrapper::AddElement(v8::Isolate* Isolate, v8::Local<v8::Context>& Context, FScriptMap* ScriptMap,
+    FPropertyTranslator* KeyPropertyTranslator, FPropertyTranslator* ValuePropertyTranslator, v8::Local<v8::Value> Key,
+    v8::Local<v8::Value> Value)
+{
+    auto Self = ScriptMap;
+    auto KeyProperty = KeyPropertyTranslator->Property;
+    auto ValueProperty = ValuePropertyTranslator->Property;
+
     void* KeyPtr = FMemory_Alloca(GetSizeWithAlignment(KeyProperty));
     KeyProperty->InitializeValue(KeyPtr);
 
     void* ValuePtr = FMemory_Alloca(GetSizeWithAlignment(ValueProperty));
     ValueProperty->InitializeValue(ValuePtr);
 
-    KeyPropertyTranslator->JsToUE(Isolate, Context, Info[0], KeyPtr, false);
-    ValuePropertyTranslator->JsToUE(Isolate, Context, Info[1], ValuePtr, false);
+    KeyPropertyTranslator->JsToUE(Isolate, Context, Key, KeyPtr, false);
+    ValuePropertyTranslator->JsToUE(Isolate, Context, Value, ValuePtr, false);
 
     auto ScriptLayout = FScriptMap::GetScriptLayout(
         KeyProperty->GetSize(), KeyProperty->GetMinAlignment(), ValueProperty->GetSize(), ValueProperty->GetMinAlignment());
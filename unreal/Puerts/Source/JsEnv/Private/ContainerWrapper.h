@@ -279,6 +279,9 @@ class FScriptArrayWrapper : public FContainerWrapper<FScriptArray>
 public:
     static v8::Local<v8::FunctionTemplate> ToFunctionTemplate(v8::Isolate* Isolate);
 
+    // 把Count个元素的原始字节拷贝进容器并把长度调整为Count，Source允许指向容器自身的内存
+    static void AssignBytes(FScriptArray* ScriptArray, int32 ElementSize, const uint8* Source, int32 Count);
+
 private:
     // 参数：一到多个容器元素
     // 返回：无
@@ -325,6 +328,36 @@ private:
     // 作用：清空容器
     static void Empty(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+    // 参数：无
+    // 返回：直接映射容器内存的TypedArray（零拷贝），结构体元素按分量展开，例如TArray<FVector>返回长度为Num*3的数组
+    // 作用：仅支持数值类型以及只包含同一种数值类型且无填充的结构体，容器扩容、删除或清空后旧的view失效（被detach，长度变为0）
+    // 注意：只有经过本wrapper的调用才会detach旧view；C++/蓝图直接修改TArray导致重新分配后，旧view指向已释放的内存，
+    // 调用过可能修改该容器的原生代码后必须先用IsViewValid检查，view不能跨帧或在yield/await之后继续使用
+    static void View(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：View返回的TypedArray
+    // 返回：bool
+    // 作用：view是否仍然指向容器当前的内存
+    static void IsViewValid(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：无
+    // 返回：TypedArray
+    // 作用：把容器内容整体拷贝到一个新的TypedArray，元素类型要求同View
+    static void ToTypedArray(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：TypedArray或者ArrayBuffer
+    // 返回：拷贝后的元素个数
+    // 作用：按字节整体拷贝进容器，容器长度调整为数据长度/元素大小，元素类型要求同View
+    static void CopyFrom(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：无
+    // 返回：js数组
+    // 作用：一次性把所有元素转换为js值（值类型，有内存拷贝）
+    static void ToArray(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 容器内存变化后detach之前View返回的ArrayBuffer
+    static void ReleaseStaleView(v8::Isolate* Isolate, v8::Local<v8::Object> Holder, FScriptArray* ScriptArray, int32 ElementSize);
+
     FORCEINLINE static int32 AddUninitialized(FScriptArray* ScriptArray, int32 ElementSize, int32 Count = 1);
 
     FORCEINLINE static uint8* GetData(FScriptArray* ScriptArray, int32 ElementSize, int32 Index);
@@ -360,6 +393,19 @@ private:
 
     static void Empty(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+    // 参数：js数组
+    // 返回：无
+    // 作用：批量添加元素
+    static void AddRange(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：无
+    // 返回：js数组
+    // 作用：一次性把所有元素转换为js值
+    static void ToArray(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    static void AddElement(v8::Isolate* Isolate, v8::Local<v8::Context>& Context, FScriptSet* ScriptSet, FPropertyTranslator* Inner,
+        v8::Local<v8::Value> Value);
+
     FORCEINLINE static int32 FindIndexInner(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
     FORCEINLINE static void InternalGet(const v8::FunctionCallbackInfo<v8::Value>& Info, bool PassByPointer);
@@ -389,6 +435,20 @@ private:
 
     static void Empty(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+    // 参数1：key数组；参数2：value数组，长度需一致
+    // 返回：无
+    // 作用：批量添加/覆盖键值对
+    static void AddRange(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：无
+    // 返回：[keys, values]两个js数组
+    // 作用：一次性把所有键值对转换为js值
+    static void ToArray(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    static void AddElement(v8::Isolate* Isolate, v8::Local<v8::Context>& Context, FScriptMap* ScriptMap,
+        FPropertyTranslator* KeyPropertyTranslator, FPropertyTranslator* ValuePropertyTranslator, v8::Local<v8::Value> Key,
+        v8::Local<v8::Value> Value);
+
     FORCEINLINE static FScriptMapLayout GetScriptLayout(const PropertyMacro* KeyProperty, const PropertyMacro* ValueProperty);
 
     FORCEINLINE static void InternalGet(const v8::FunctionCallbackInfo<v8::Value>& Info, bool PassByPointer);
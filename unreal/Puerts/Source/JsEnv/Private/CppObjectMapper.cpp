@@ -204,6 +204,10 @@ v8::Local<v8::FunctionTemplate> FCppObjectMapper::GetTemplateOfClass(v8::Isolate
             ++PropertyInfo;
         }
 
+#ifdef WITH_V8_FAST_CALL
+        // 重载的ReflectionInfo为空，从MethodInfos/FunctionInfos里收集同名的fast call
+        std::vector<v8::CFunction> FastCallOverloads;
+#endif
         JSFunctionInfo* FunctionInfo = ClassDefinition->Methods;
         while (FunctionInfo && FunctionInfo->Name && FunctionInfo->Callback)
         {
@@ -217,6 +221,17 @@ v8::Local<v8::FunctionTemplate> FCppObjectMapper::GetTemplateOfClass(v8::Isolate
                         v8::External::New(Isolate, &FunctionInfo->Data), v8::Local<v8::Signature>(), 0,
                         v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect, FastCallInfo));
             }
+#ifdef WITH_V8_FAST_CALL
+            else if (CollectFastCallOverloads(ClassDefinition->MethodInfos, FunctionInfo->Name, FastCallOverloads))
+            {
+                Template->PrototypeTemplate()->Set(
+                    v8::String::NewFromUtf8(Isolate, FunctionInfo->Name, v8::NewStringType::kNormal).ToLocalChecked(),
+                    v8::FunctionTemplate::NewWithCFunctionOverloads(Isolate, (v8::FunctionCallback) FunctionInfo->Callback,
+                        v8::External::New(Isolate, &FunctionInfo->Data), v8::Local<v8::Signature>(), 0,
+                        v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
+                        v8::MemorySpan<const v8::CFunction>(FastCallOverloads.data(), FastCallOverloads.size())));
+            }
+#endif
             else
 #endif
             {
@@ -244,6 +259,16 @@ v8::Local<v8::FunctionTemplate> FCppObjectMapper::GetTemplateOfClass(v8::Isolate
                         v8::External::New(Isolate, &FunctionInfo->Data), v8::Local<v8::Signature>(), 0,
                         v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect, FastCallInfo));
             }
+#ifdef WITH_V8_FAST_CALL
+            else if (CollectFastCallOverloads(ClassDefinition->FunctionInfos, FunctionInfo->Name, FastCallOverloads))
+            {
+                Template->Set(v8::String::NewFromUtf8(Isolate, FunctionInfo->Name, v8::NewStringType::kNormal).ToLocalChecked(),
+                    v8::FunctionTemplate::NewWithCFunctionOverloads(Isolate, (v8::FunctionCallback) FunctionInfo->Callback,
+                        v8::External::New(Isolate, &FunctionInfo->Data), v8::Local<v8::Signature>(), 0,
+                        v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
+                        v8::MemorySpan<const v8::CFunction>(FastCallOverloads.data(), FastCallOverloads.size())));
+            }
+#endif
             else
 #endif
             {
@@ -9,6 +9,7 @@
 #include "FunctionTranslator.h"
 #include "V8Utils.h"
 #include "Misc/DefaultValueHelper.h"
+#include <atomic>
 #include <mutex>
 
 static TMap<FName, TMap<FName, TMap<FName, FString>>> ParamDefaultMetas;
@@ -86,6 +87,58 @@ public:
 static GlobalBufferAutoRelease Dummy;
 #endif
 
+static std::atomic<bool> ProfileEnabled(false);
+static FCriticalSection ProfileLock;
+static TMap<UFunction*, FFunctionCallProfile> ProfileRecords;
+
+void FFunctionTranslator::SetProfileEnabled(bool Enabled)
+{
+    FScopeLock ScopeLock(&ProfileLock);
+    if (Enabled && !ProfileEnabled)
+    {
+        ProfileRecords.Empty();
+    }
+    ProfileEnabled = Enabled;
+}
+
+bool FFunctionTranslator::IsProfileEnabled()
+{
+    return ProfileEnabled;
+}
+
+void FFunctionTranslator::GetProfileRecords(TArray<FFunctionCallProfile>& OutRecords)
+{
+    FScopeLock ScopeLock(&ProfileLock);
+    OutRecords.Reset(ProfileRecords.Num());
+    for (auto& Pair : ProfileRecords)
+    {
+        if (Pair.Value.Function.IsValid())
+        {
+            OutRecords.Add(Pair.Value);
+        }
+    }
+    OutRecords.Sort([](const FFunctionCallProfile& A, const FFunctionCallProfile& B) { return A.Seconds > B.Seconds; });
+}
+
+void FFunctionTranslator::RecordProfile(uint64 Cycles) const
+{
+    UFunction* Func = Function.Get();
+    if (!Func)
+    {
+        return;
+    }
+    FScopeLock ScopeLock(&ProfileLock);
+    FFunctionCallProfile& Record = ProfileRecords.FindOrAdd(Func);
+    // 地址被新的UFunction复用时重新计数
+    if (Record.Function.Get() != Func)
+    {
+        Record = FFunctionCallProfile();
+        Record.Function = Func;
+    }
+    ++Record.Calls;
+    Record.Seconds += FPlatformTime::ToSeconds64(Cycles);
+}
+
 FFunctionTranslator::FFunctionTranslator(UFunction* InFunction, bool IsDelegate)
 {
     Init(InFunction, IsDelegate);
@@ -136,6 +189,21 @@ void FFunctionTranslator::Init(UFunction* InFunction, bool IsDelegate)
         }
     }
 
+    ArgumentPlans.clear();
+    ArgumentPlans.resize(Arguments.size());
+    for (size_t i = 0; i < Arguments.size(); ++i)
+    {
+        auto PropertyFlags = Arguments[i]->Property->PropertyFlags;
+        ArgumentPlans[i].WriteBackOut = (PropertyFlags & CPF_OutParm) && !(PropertyFlags & CPF_ConstParm);
+        ArgumentPlans[i].NeedDestroy =
+            Arguments[i]->ParamShallowCopySize == 0 && !(PropertyFlags & (CPF_IsPlainOldData | CPF_NoDestructor));
+    }
+
+    BuildCallPlan(InFunction, DefaultCallPlan);
+    InterfaceCallPlans.Empty();
+    LastInterfaceClass = nullptr;
+    LastInterfaceCallPlan = nullptr;
+
     ArgumentDefaultValues = nullptr;
 
     if (!IsDelegate)
@@ -211,6 +279,61 @@ void FFunctionTranslator::Init(UFunction* InFunction, bool IsDelegate)
     }
 }
 
+void FFunctionTranslator::BuildCallPlan(UFunction* CallFunction, FCallPlan& OutPlan) const
+{
+    OutPlan.CallFunction = CallFunction;
+    OutPlan.Params.clear();
+    OutPlan.OutProperties.clear();
+    OutPlan.ArgumentOutIndices.assign(Arguments.size(), -1);
+    OutPlan.ReturnValueOffset = CallFunction->ReturnValueOffset;
+
+    int32 ArgumentIndex = 0;
+    for (TFieldIterator<PropertyMacro> It(CallFunction); It && (It->PropertyFlags & CPF_Parm); ++It)
+    {
+        FParamPlan Param;
+        Param.Property = *It;
+        if (Param.Property->HasAnyPropertyFlags(CPF_OutParm))
+        {
+            Param.OutIndex = static_cast<int32>(OutPlan.OutProperties.size());
+            OutPlan.OutProperties.push_back(Param.Property);
+        }
+        if (!Param.Property->HasAnyPropertyFlags(CPF_ReturnParm))
+        {
+            Param.ArgumentIndex = ArgumentIndex++;
+            if (Param.OutIndex >= 0 && Param.ArgumentIndex < static_cast<int32>(OutPlan.ArgumentOutIndices.size()))
+            {
+                OutPlan.ArgumentOutIndices[Param.ArgumentIndex] = Param.OutIndex;
+            }
+        }
+        OutPlan.Params.push_back(Param);
+    }
+}
+
+const FFunctionTranslator::FCallPlan* FFunctionTranslator::FindInterfaceCallPlan(UClass* Class)
+{
+    if (LIKELY(LastInterfaceCallPlan && LastInterfaceClass.Get() == Class && LastInterfaceCallPlan->CallFunction.IsValid()))
+    {
+        return LastInterfaceCallPlan;
+    }
+
+    FCallPlan* Plan = InterfaceCallPlans.Find(Class);
+    if (!Plan || !Plan->CallFunction.IsValid())
+    {
+        UFunction* CallFunction = Class->FindFunctionByName(Function->GetFName());
+        if (!CallFunction)
+        {
+            return nullptr;
+        }
+        // Add可能使之前返回的指针失效
+        LastInterfaceCallPlan = nullptr;
+        Plan = &InterfaceCallPlans.Add(Class);
+        BuildCallPlan(CallFunction, *Plan);
+    }
+    LastInterfaceClass = Class;
+    LastInterfaceCallPlan = Plan;
+    return Plan;
+}
+
 v8::Local<v8::FunctionTemplate> FFunctionTranslator::ToFunctionTemplate(v8::Isolate* Isolate)
 {
     return v8::FunctionTemplate::New(Isolate, Call, v8::External::New(Isolate, this));
@@ -247,31 +370,45 @@ void FFunctionTranslator::Call(
         FV8Utils::ThrowException(Isolate, "access a invalid object");
         return;
     }
-    TWeakObjectPtr<UFunction> CallFunction =
-        !IsInterfaceFunction ? Function : (CallObject->GetClass()->FindFunctionByName(Function->GetFName()));
+    const FCallPlan* Plan = !IsInterfaceFunction ? &DefaultCallPlan : FindInterfaceCallPlan(CallObject->GetClass());
+    UFunction* CallFunctionPtr = Plan ? Plan->CallFunction.Get() : nullptr;
 #if defined(USE_GLOBAL_PARAMS_BUFFER)
     void* Params = Buffer;
 #else
     void* Params = ParamsBufferSize > 0 ? FMemory_Alloca(ParamsBufferSize) : nullptr;
 #endif
 #if WITH_EDITOR
-    if (!CallFunction.IsValid())
+    if (!CallFunctionPtr)
     {
-        CallFunction = CallObject->GetClass()->FindFunctionByName(FunctionName);
-        Init(CallFunction.Get(), false);
+        CallFunctionPtr = CallObject->GetClass()->FindFunctionByName(FunctionName);
+        if (CallFunctionPtr)
+        {
+            Init(CallFunctionPtr, false);
+            Plan = !IsInterfaceFunction ? &DefaultCallPlan : FindInterfaceCallPlan(CallObject->GetClass());
+            CallFunctionPtr = Plan ? Plan->CallFunction.Get() : nullptr;
+        }
     }
 #endif
+    if (!CallFunctionPtr)
+    {
+        FV8Utils::ThrowException(Isolate, "can not find the function to call");
+        return;
+    }
 
-    auto CallFunctionPtr = CallFunction.Get();
+    const uint64 Begin = UNLIKELY(ProfileEnabled.load(std::memory_order_relaxed)) ? FPlatformTime::Cycles64() : 0;
     if ((Function->FunctionFlags & FUNC_Native) && !(Function->FunctionFlags & FUNC_Net) &&
         !CallFunctionPtr->HasAnyFunctionFlags(FUNC_UbergraphFunction))
     {
-        FastCall(Isolate, Context, Info, CallObject, CallFunctionPtr, Params);
+        FastCall(Isolate, Context, Info, CallObject, *Plan, CallFunctionPtr, Params);
     }
     else
     {
         SlowCall(Isolate, Context, Info, CallObject, CallFunctionPtr, Params);
     }
+    if (UNLIKELY(Begin != 0))
+    {
+        RecordProfile(FPlatformTime::Cycles64() - Begin);
+    }
 }
 
 void FFunctionTranslator::SlowCall(v8::Isolate* Isolate, v8::Local<v8::Context>& Context,
@@ -293,7 +430,8 @@ void FFunctionTranslator::SlowCall(v8::Isolate* Isolate, v8::Local<v8::Context>&
 }
 
 void FFunctionTranslator::FastCall(v8::Isolate* Isolate, v8::Local<v8::Context>& Context,
-    const v8::FunctionCallbackInfo<v8::Value>& Info, UObject* CallObject, UFunction* CallFunction, void* Params)
+    const v8::FunctionCallbackInfo<v8::Value>& Info, UObject* CallObject, const FCallPlan& Plan, UFunction* CallFunction,
+    void* Params)
 {
     if (Params)
     {
@@ -312,42 +450,40 @@ void FFunctionTranslator::FastCall(v8::Isolate* Isolate, v8::Local<v8::Context>&
     );
 
     checkSlow(NewStack.Locals || Function->ParmsSize == 0);
-    FOutParmRec** LastOut = &NewStack.OutParms;
-    int Index = 0;
-    for (TFieldIterator<PropertyMacro> It(CallFunction); It && (It->PropertyFlags & CPF_Parm); ++It)
+    const int32 OutParmsNum = static_cast<int32>(Plan.OutProperties.size());
+    FOutParmRec* OutParms = nullptr;
+    if (OutParmsNum > 0)
     {
-        PropertyMacro* Property = *It;
-        FOutParmRec* Out = nullptr;
-        if (Property->HasAnyPropertyFlags(CPF_OutParm))
+        CA_SUPPRESS(6263)
+        OutParms = (FOutParmRec*) FMemory_Alloca(sizeof(FOutParmRec) * OutParmsNum);
+        for (int32 i = 0; i < OutParmsNum; ++i)
         {
-            CA_SUPPRESS(6263)
-            Out = (FOutParmRec*) FMemory_Alloca(sizeof(FOutParmRec));
-            Out->Property = Property;
-
-            if (*LastOut)
-            {
-                (*LastOut)->NextOutParm = Out;
-                LastOut = &(*LastOut)->NextOutParm;
-            }
-            else
-            {
-                *LastOut = Out;
-            }
+            OutParms[i].Property = Plan.OutProperties[i];
+            OutParms[i].PropAddr = nullptr;
+            OutParms[i].NextOutParm = i + 1 < OutParmsNum ? &OutParms[i + 1] : nullptr;
         }
+        NewStack.OutParms = OutParms;
+    }
 
-        if (Property->HasAnyPropertyFlags(CPF_ReturnParm))
+    for (const FParamPlan& Param : Plan.Params)
+    {
+        PropertyMacro* Property = Param.Property;
+        FOutParmRec* Out = Param.OutIndex >= 0 ? &OutParms[Param.OutIndex] : nullptr;
+
+        if (Param.ArgumentIndex < 0)
         {
-            if (Property->HasAnyPropertyFlags(CPF_OutParm))
+            if (Out)
             {
                 Out->PropAddr = Property->ContainerPtrToValuePtr<uint8>(Params);
             }
             continue;
         }
 
+        const int Index = Param.ArgumentIndex;
         if (UNLIKELY(ArgumentDefaultValues && Info[Index]->IsUndefined()))
         {
             Property->CopyCompleteValue_InContainer(Params, ArgumentDefaultValues);
-            if (Property->HasAnyPropertyFlags(CPF_OutParm))
+            if (Out)
             {
                 Out->PropAddr = Property->ContainerPtrToValuePtr<uint8>(Params);
             }
@@ -355,7 +491,7 @@ void FFunctionTranslator::FastCall(v8::Isolate* Isolate, v8::Local<v8::Context>&
         else
         {
             Property->InitializeValue_InContainer(Params);
-            if (Property->HasAnyPropertyFlags(CPF_OutParm))
+            if (Out)
             {
                 if (!Arguments[Index]->JsToUEFastInContainer(
                         Isolate, Context, Info[Index], Params, reinterpret_cast<void**>(&(Out->PropAddr))))
@@ -371,18 +507,9 @@ void FFunctionTranslator::FastCall(v8::Isolate* Isolate, v8::Local<v8::Context>&
                 }
             }
         }
-        ++Index;
-    }
-    if (CallFunction->HasAnyFunctionFlags(FUNC_HasOutParms))
-    {
-        if (*LastOut)
-        {
-            (*LastOut)->NextOutParm = NULL;
-        }
     }
 
-    const bool bHasReturnParam = CallFunction->ReturnValueOffset != MAX_uint16;
-    uint8* ReturnValueAddress = bHasReturnParam ? ((uint8*) Params + CallFunction->ReturnValueOffset) : nullptr;
+    uint8* ReturnValueAddress = Plan.ReturnValueOffset != MAX_uint16 ? ((uint8*) Params + Plan.ReturnValueOffset) : nullptr;
     CallFunction->Invoke(CallObject, NewStack, ReturnValueAddress);
 
     if (Return)
@@ -391,27 +518,19 @@ void FFunctionTranslator::FastCall(v8::Isolate* Isolate, v8::Local<v8::Context>&
         Return->Property->DestroyValue_InContainer(Params);
     }
 
-    LastOut = &NewStack.OutParms;
     for (int i = 0; i < Arguments.size(); ++i)
     {
-        auto PropertyFlags = Arguments[i]->Property->PropertyFlags;
-        if (PropertyFlags & CPF_OutParm)
+        const int32 OutIndex = Plan.ArgumentOutIndices[i];
+        if (OutIndex >= 0 && ArgumentPlans[i].WriteBackOut)
         {
-            if ((PropertyFlags & CPF_Parm) && (!(PropertyFlags & CPF_ConstParm)) && (!(PropertyFlags & CPF_ReturnParm)))
+            uint8* PropAddr = OutParms[OutIndex].PropAddr;
+            if (PropAddr < (uint8*) Params || PropAddr >= ((uint8*) Params + ParamsBufferSize))
             {
-                if ((*LastOut)->PropAddr >= (uint8*) Params && (*LastOut)->PropAddr < ((uint8*) Params + ParamsBufferSize))
-                {
-                    Arguments[i]->UEOutToJsInContainer(Isolate, Context, Info[i], Params, false);
-                }
-                else
-                {
-                    LastOut = &(*LastOut)->NextOutParm;
-                    continue;
-                }
+                continue;
             }
-            LastOut = &(*LastOut)->NextOutParm;
+            Arguments[i]->UEOutToJsInContainer(Isolate, Context, Info[i], Params, false);
         }
-        if (Arguments[i]->ParamShallowCopySize == 0)
+        if (ArgumentPlans[i].NeedDestroy)
         {
             Arguments[i]->Property->DestroyValue_InContainer(Params);
         }
@@ -27,6 +27,13 @@ PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 
 namespace PUERTS_NAMESPACE
 {
+struct FFunctionCallProfile
+{
+    TWeakObjectPtr<UFunction> Function;
+    uint64 Calls = 0;
+    double Seconds = 0;
+};
+
 class FFunctionTranslator
 {
 public:
@@ -53,6 +60,13 @@ public:
 
     bool IsValid() const;
 
+    // profile模式下统计每个UFunction从js调用的次数和耗时(含参数转换)，所有虚拟机共享，开启时清空已有记录
+    static void SetProfileEnabled(bool Enabled);
+
+    static bool IsProfileEnabled();
+
+    static void GetProfileRecords(TArray<FFunctionCallProfile>& OutRecords);
+
 protected:
     FORCEINLINE bool Call_ProcessParams(v8::Isolate* Isolate, v8::Local<v8::Context>& Context,
         const v8::FunctionCallbackInfo<v8::Value>& Info, void* Params, int StartPos)
@@ -90,13 +104,56 @@ protected:
         for (int i = StartPos; i < Arguments.size(); ++i)
         {
             Arguments[i]->UEOutToJsInContainer(Isolate, Context, Info[i - StartPos], Params, false);
-            if (Arguments[i]->ParamShallowCopySize == 0)
+            if (ArgumentPlans[i].NeedDestroy)
             {
                 Arguments[i]->Property->DestroyValue_InContainer(Params);
             }
         }
     }
 
+    struct FArgumentPlan
+    {
+        // 非const的out参数，调用后需要写回js
+        bool WriteBackOut = false;
+        // 非浅拷贝且有析构的参数才需要DestroyValue
+        bool NeedDestroy = false;
+    };
+
+    struct FParamPlan
+    {
+        PropertyMacro* Property = nullptr;
+        // 在Arguments里的下标，返回值为-1
+        int32 ArgumentIndex = -1;
+        // 在FOutParmRec链里的下标，不是out参数为-1
+        int32 OutIndex = -1;
+    };
+
+    // 一个实际被调用的UFunction的参数布局，FastCall按它直接填参数和FOutParmRec链，不再遍历属性
+    struct FCallPlan
+    {
+        TWeakObjectPtr<UFunction> CallFunction;
+        std::vector<FParamPlan> Params;
+        std::vector<PropertyMacro*> OutProperties;
+        // Arguments[i]对应的FOutParmRec下标
+        std::vector<int32> ArgumentOutIndices;
+        uint16 ReturnValueOffset = MAX_uint16;
+    };
+
+    void BuildCallPlan(UFunction* CallFunction, FCallPlan& OutPlan) const;
+
+    // 接口函数按实现类缓存解析结果，找不到实现返回nullptr
+    const FCallPlan* FindInterfaceCallPlan(UClass* Class);
+
+    std::vector<FArgumentPlan> ArgumentPlans;
+
+    FCallPlan DefaultCallPlan;
+
+    TMap<TWeakObjectPtr<UClass>, FCallPlan> InterfaceCallPlans;
+
+    TWeakObjectPtr<UClass> LastInterfaceClass;
+
+    const FCallPlan* LastInterfaceCallPlan = nullptr;
+
     std::vector<std::unique_ptr<FPropertyTranslator>> Arguments;
 
     std::unique_ptr<FPropertyTranslator> Return;
@@ -126,7 +183,9 @@ private:
         UObject* CallObject, UFunction* CallFunction, void* Params);
 
     void FastCall(v8::Isolate* Isolate, v8::Local<v8::Context>& Context, const v8::FunctionCallbackInfo<v8::Value>& Info,
-        UObject* CallObject, UFunction* CallFunction, void* Params);
+        UObject* CallObject, const FCallPlan& Plan, UFunction* CallFunction, void* Params);
+
+    void RecordProfile(uint64 Cycles) const;
 
     void Init(UFunction* InFunction, bool IsDelegate);
 
@@ -8,6 +8,9 @@
 
 #include "JsEnv.h"
 #include "JsEnvImpl.h"
+#if !defined(ENGINE_INDEPENDENT_JSENV)
+#include "JsEnvGroup.h"
+#endif
 
 namespace PUERTS_NAMESPACE
 {
@@ -57,6 +60,7 @@ void FJsEnv::WaitDebugger(double timeout)
 #if !defined(ENGINE_INDEPENDENT_JSENV)
 void FJsEnv::TryBindJs(const class UObjectBase* InObject)
 {
+    FJsEnvGroup::CountTryBindJsDispatched();
     GameScript->TryBindJs(InObject);
 }
 
@@ -13,6 +13,8 @@
 #include "DynamicInvoker.h"
 #include "PuertsNamespaceDef.h"
 
+#include <atomic>
+
 namespace PUERTS_NAMESPACE
 {
 class FGroupDynamicInvoker : public ITsDynamicInvoker, public IDynamicInvoker
@@ -136,8 +138,48 @@ FJsEnvGroup::~FJsEnvGroup()
     JsEnvList.clear();
 }
 
+static std::atomic<uint64> TryBindJsCreated(0);
+static std::atomic<uint64> TryBindJsRejected(0);
+static std::atomic<uint64> TryBindJsDispatched(0);
+
+bool FJsEnvGroup::NeedTryBindJs(const class UObjectBase* InObject)
+{
+    TryBindJsCreated.fetch_add(1, std::memory_order_relaxed);
+
+    // 和FJsEnvImpl::TryBindJs里处理的两种情况一致
+    UClass* Class = InObject->GetClass();
+    if (UNLIKELY(Class == UTypeScriptGeneratedClass::StaticClass()))
+    {
+        return true;
+    }
+    if (UNLIKELY(static_cast<const UObjectBaseUtility*>(InObject)->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) &&
+                 Class->IsA<UTypeScriptGeneratedClass>()))
+    {
+        return true;
+    }
+
+    TryBindJsRejected.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void FJsEnvGroup::CountTryBindJsDispatched()
+{
+    TryBindJsDispatched.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FJsEnvGroup::GetTryBindJsStatistics(uint64& OutCreated, uint64& OutBound, uint64& OutRejected)
+{
+    OutCreated = TryBindJsCreated.load(std::memory_order_relaxed);
+    OutBound = TryBindJsDispatched.load(std::memory_order_relaxed);
+    OutRejected = TryBindJsRejected.load(std::memory_order_relaxed);
+}
+
 void FJsEnvGroup::TryBindJs(const class UObjectBase* InObject)
 {
+    if (!JsEnvList.empty())
+    {
+        CountTryBindJsDispatched();
+    }
     for (int i = 0; i < JsEnvList.size(); i++)
     {
         JsEnvList[i]->TryBindJs(InObject);
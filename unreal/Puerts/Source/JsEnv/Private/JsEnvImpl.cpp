@@ -23,6 +23,7 @@
 #include "JSAnimGeneratedClass.h"
 #include "JSWidgetGeneratedClass.h"
 #include "JSGeneratedFunction.h"
+#include "JsEnvGroup.h"
 #endif
 #include "JSClassRegister.h"
 #include "PromiseRejectCallback.hpp"
@@ -88,6 +89,8 @@ PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 
 #if defined(WITH_WEBSOCKET)
 void InitWebsocketPPWrap(v8::Local<v8::Context> Context);
+
+void UnInitWebsocketPPWrap(v8::Isolate* Isolate);
 #endif
 
 namespace PUERTS_NAMESPACE
@@ -130,6 +133,12 @@ static void ToCString(const v8::FunctionCallbackInfo<v8::Value>& Info)
     Info.GetReturnValue().Set(Ab);
 }
 
+// 定时器时间轮使用的单调时钟，毫秒
+static int64_t TimerNowMilliseconds()
+{
+    return static_cast<int64_t>(FPlatformTime::Seconds() * 1000.0);
+}
+
 static void ToCPtrArray(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     const size_t Length = sizeof(void*) * Info.Length();
@@ -548,6 +557,21 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 
     MethodBindingHelper<&FJsEnvImpl::DumpStatisticsLog>::Bind(Isolate, Context, Global, "dumpStatisticsLog", This);
 
+    MethodBindingHelper<&FJsEnvImpl::GetTimerStatistics>::Bind(Isolate, Context, Global, "getTimerStatistics", This);
+
+    MethodBindingHelper<&FJsEnvImpl::GetUObjectDeleteFilterStatistics>::Bind(
+        Isolate, Context, Global, "getUObjectDeleteFilterStatistics", This);
+
+#if !defined(ENGINE_INDEPENDENT_JSENV)
+    MethodBindingHelper<&FJsEnvImpl::GetTryBindJsStatistics>::Bind(Isolate, Context, Global, "getTryBindJsStatistics", This);
+#endif
+
+    MethodBindingHelper<&FJsEnvImpl::SetFunctionProfile>::Bind(Isolate, Context, Global, "setFunctionProfile", This);
+
+    MethodBindingHelper<&FJsEnvImpl::GetFunctionProfile>::Bind(Isolate, Context, Global, "getFunctionProfile", This);
+
+    MethodBindingHelper<&FJsEnvImpl::BenchmarkMergeObject>::Bind(Isolate, Context, Global, "benchmarkMergeObject", This);
+
     Global
         ->Set(Context, FV8Utils::ToV8String(Isolate, "__tgjsFNameToArrayBuffer"),
             v8::FunctionTemplate::New(Isolate, FNameToArrayBuffer)->GetFunction(Context).ToLocalChecked())
@@ -646,6 +670,9 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
     DelegateProxiesCheckerHandler =
         FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::CheckDelegateProxies), 1);
 
+    TimerWheel = FTimerWheel(TimerNowMilliseconds());
+    TimerTickerHandle = FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::TickTimers), 0);
+
     ManualReleaseCallbackMap.Reset(Isolate, v8::Map::New(Isolate));
 
     UserObjectRetainer.SetName(TEXT("Puerts_UserObjectRetainer"));
@@ -700,6 +727,9 @@ FJsEnvImpl::~FJsEnvImpl()
 #if defined(WITH_NODEJS)
     StopPolling();
 #endif
+#if defined(WITH_WEBSOCKET)
+    UnInitWebsocketPPWrap(MainIsolate);
+#endif
 
 #ifndef WITH_QUICKJS
     for (auto& KV : HashToModuleInfo)
@@ -725,6 +755,7 @@ FJsEnvImpl::~FJsEnvImpl()
     JsPromiseRejectCallback.Reset();
 
     FUETicker::GetCoreTicker().RemoveTicker(DelegateProxiesCheckerHandler);
+    FUETicker::GetCoreTicker().RemoveTicker(TimerTickerHandle);
 
     {
         auto Isolate = MainIsolate;
@@ -807,7 +838,7 @@ FJsEnvImpl::~FJsEnvImpl()
         for (auto Iter = TimerInfos.CreateIterator(); Iter; ++Iter)
         {
             Iter->Value.Callback.Reset();
-            FUETicker::GetCoreTicker().RemoveTicker(Iter->Value.TickerHandle);
+            TimerWheel.Remove(Iter->Key);
         }
         TimerInfos.Empty();
 
@@ -873,6 +904,7 @@ FJsEnvImpl::~FJsEnvImpl()
 #if !PUERTS_FORCE_CPP_UFUNCTION
         MergePrototype.Reset();
 #endif
+        ObjectMergers.clear();
         RemoveListItem.Reset();
         GenListApply.Reset();
 #if defined(WITH_V8_BYTECODE)
@@ -985,6 +1017,109 @@ std::unique_ptr<FJsEnvImpl::ObjectMerger>& FJsEnvImpl::GetObjectMerger(UStruct*
     return ObjectMergers[Struct];
 }
 
+FJsEnvImpl::ObjectMerger::ObjectMerger(FJsEnvImpl* InParent, UStruct* InStruct)
+{
+    Parent = InParent;
+    Struct = InStruct;
+
+    v8::Isolate* Isolate = Parent->MainIsolate;
+    v8::HandleScope HandleScope(Isolate);
+    for (TFieldIterator<PropertyMacro> It(Struct); It; ++It)
+    {
+        PropertyMacro* Property = *It;
+        TStringConversion<TStringConvert<TCHAR, ANSICHAR>> Name(*Property->GetName());
+
+        FField Field;
+        // 内部化的key，Get时v8按指针比较属性名
+        Field.Key.Reset(Isolate, v8::String::NewFromUtf8(Isolate, Name.Get(), v8::NewStringType::kInternalized).ToLocalChecked());
+        Field.Translator = FPropertyTranslator::Create(Property);
+        if (auto ObjectPropertyBase = CastFieldMacro<ObjectPropertyBaseMacro>(Property))
+        {
+            Field.FieldStruct = ObjectPropertyBase->PropertyClass;
+        }
+        else if (auto StructProperty = CastFieldMacro<StructPropertyMacro>(Property))
+        {
+            Field.FieldStruct = StructProperty->Struct;
+        }
+        FieldIndexByName[Name.Get()] = Fields.size();
+        Fields.push_back(std::move(Field));
+    }
+}
+
+void FJsEnvImpl::ObjectMerger::Merge(
+    v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Object> JsObject, void* Ptr, EMergeMode Mode)
+{
+    if (auto Class = Cast<UClass>(Struct))
+    {
+        UObject* Object = reinterpret_cast<UObject*>(Ptr);
+        if (!Object->IsValidLowLevel() || UEObjectIsPendingKill(Object) || Object->GetClass() != Class ||
+            FV8Utils::GetPointer(JsObject))
+        {
+            return;
+        }
+    }
+
+    bool ByField = Mode == EMergeMode::ByField || (Mode == EMergeMode::Auto && Fields.size() <= kMaxFieldDrivenFields);
+    if (ByField)
+    {
+        for (auto& Field : Fields)
+        {
+            v8::Local<v8::Value> Value;
+            if (!JsObject->Get(Context, Field.Key.Get(Isolate)).ToLocal(&Value))
+            {
+                return;
+            }
+            if (!Value->IsUndefined())
+            {
+                MergeField(Isolate, Context, Field, Value, Ptr, Mode);
+            }
+        }
+        return;
+    }
+
+    auto Keys = JsObject->GetOwnPropertyNames(Context).ToLocalChecked();
+    for (decltype(Keys->Length()) i = 0; i < Keys->Length(); ++i)
+    {
+        auto Key = Keys->Get(Context, i).ToLocalChecked();
+        auto Iter = FieldIndexByName.find(*v8::String::Utf8Value(Isolate, Key));
+        if (Iter != FieldIndexByName.end())
+        {
+            v8::Local<v8::Value> Value;
+            if (!JsObject->Get(Context, Key).ToLocal(&Value))
+            {
+                return;
+            }
+            if (!Value->IsUndefined())
+            {
+                MergeField(Isolate, Context, Fields[Iter->second], Value, Ptr, Mode);
+            }
+        }
+    }
+}
+
+void FJsEnvImpl::ObjectMerger::MergeField(
+    v8::Isolate* Isolate, v8::Local<v8::Context> Context, FField& Field, v8::Local<v8::Value> Value, void* Ptr, EMergeMode Mode)
+{
+    if (Value->IsObject())
+    {
+        auto JsObjectField = Value.As<v8::Object>();
+        if (!FV8Utils::GetPointerFast<void>(JsObjectField))
+        {
+            if (Field.FieldStruct)
+            {
+                if (!Field.FieldMerger)
+                {
+                    Field.FieldMerger = Parent->GetObjectMerger(Field.FieldStruct).get();
+                }
+                Field.FieldMerger->Merge(
+                    Isolate, Context, JsObjectField, Field.Translator->Property->ContainerPtrToValuePtr<void>(Ptr), Mode);
+            }
+            return;
+        }
+    }
+    Field.Translator->JsToUEInContainer(Isolate, Context, Value, Ptr, true);
+}
+
 void FJsEnvImpl::Merge(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Object> Src, UStruct* DesType, void* Des)
 {
     GetObjectMerger(DesType)->Merge(Isolate, Context, Src, Des);
@@ -1002,6 +1137,16 @@ void FJsEnvImpl::MergeObject(const v8::FunctionCallbackInfo<v8::Value>& Info)
 
     auto Des = Info[0]->ToObject(Context).ToLocalChecked();
     auto Src = Info[1]->ToObject(Context).ToLocalChecked();
+    UStruct* DesType = nullptr;
+    void* DesPtr = nullptr;
+    if (GetMergeTarget(Isolate, Des, DesType, DesPtr))
+    {
+        Merge(Isolate, Context, Src, DesType, DesPtr);
+    }
+}
+
+bool FJsEnvImpl::GetMergeTarget(v8::Isolate* Isolate, v8::Local<v8::Object> Des, UStruct*& OutStruct, void*& OutPtr)
+{
     if (FV8Utils::GetPointerFast<void>(Des, 1))    // struct
     {
         if (auto Object = FV8Utils::GetUObject(Des, 1))
@@ -1009,13 +1154,14 @@ void FJsEnvImpl::MergeObject(const v8::FunctionCallbackInfo<v8::Value>& Info)
             if (FV8Utils::IsReleasedPtr(Object))
             {
                 FV8Utils::ThrowException(Isolate, "passing a invalid object");
-                return;
+                return false;
             }
             auto Struct = Cast<UScriptStruct>(Object);
             if (Struct)
             {
-                Merge(Isolate, Context, Src, Struct, FV8Utils::GetPointer(Des));
-                return;
+                OutStruct = Struct;
+                OutPtr = FV8Utils::GetPointer(Des);
+                return true;
             }
         }
     }
@@ -1027,13 +1173,15 @@ void FJsEnvImpl::MergeObject(const v8::FunctionCallbackInfo<v8::Value>& Info)
             if (FV8Utils::IsReleasedPtr(Object))
             {
                 FV8Utils::ThrowException(Isolate, "passing a invalid object");
-                return;
+                return false;
             }
-            Merge(Isolate, Context, Src, Object->GetClass(), Object);
-            return;
+            OutStruct = Object->GetClass();
+            OutPtr = Object;
+            return true;
         }
     }
     FV8Utils::ThrowException(Isolate, "Bad parameters #1, expect a native object.");
+    return false;
 }
 
 void FJsEnvImpl::NewObjectByClass(const v8::FunctionCallbackInfo<v8::Value>& Info)
@@ -1257,6 +1405,7 @@ void FJsEnvImpl::MakeSureInject(UTypeScriptGeneratedClass* TypeScriptGeneratedCl
                 BindInfo.Prototype.Reset(Isolate, v8::Object::New(Isolate));
                 BindInfo.InjectNotFinished = true;
                 BindInfoMap.Emplace(TypeScriptGeneratedClass, std::move(BindInfo));
+                AddToDeleteFilter(TypeScriptGeneratedClass);
             }
 
             v8::TryCatch TryCatch(Isolate);
@@ -1361,6 +1510,7 @@ void FJsEnvImpl::MakeSureInject(UTypeScriptGeneratedClass* TypeScriptGeneratedCl
                                             Function, {v8::UniquePersistent<v8::Function>(
                                                            Isolate, v8::Local<v8::Function>::Cast(MaybeValue.ToLocalChecked())),
                                                           std::make_unique<FFunctionTranslator>(Function, false)});
+                                        AddToDeleteFilter(Function);
                                     }
                                     else
                                     {
@@ -1740,6 +1890,7 @@ void FJsEnvImpl::Bind(FClassWrapper* ClassWrapper, UObject* UEObject,
     DataTransfer::SetPointer(MainIsolate, JSObject, UEObject, 0);
     DataTransfer::SetPointer(MainIsolate, JSObject, nullptr, 1);
     ObjectMap.Emplace(UEObject, v8::UniquePersistent<v8::Value>(MainIsolate, JSObject));
+    AddToDeleteFilter(UEObject);
 
     if (!IsNativeTakeJsRef)
     {
@@ -1986,6 +2137,7 @@ void FJsEnvImpl::JsConstruct(UClass* Class, UObject* Object, const v8::UniquePer
     // 过时功能(makeUClass)用不影响现有功能的方式修改
     UnBind(Class, Object);
     ObjectMap.Emplace(Object, v8::UniquePersistent<v8::Value>(MainIsolate, JSObject));
+    AddToDeleteFilter(Object);
 
     if (!Prototype.IsEmpty())
     {
@@ -2103,6 +2255,14 @@ void FJsEnvImpl::NotifyUObjectDeleted(const class UObjectBase* ObjectBase, int32
     v8::Locker Locker(MainIsolate);
 #endif
 
+    ++DeleteFilterStats.Checks;
+    if (!DeleteFilter.MayContain(ObjectBase))
+    {
+        ++DeleteFilterStats.Rejected;
+        return;
+    }
+    const int32 TrackedBefore = NumDeleteFilterTracked();
+
     TryReleaseType((UStruct*) ObjectBase);
 
 #if !defined(ENGINE_INDEPENDENT_JSENV)
@@ -2130,6 +2290,11 @@ void FJsEnvImpl::NotifyUObjectDeleted(const class UObjectBase* ObjectBase, int32
         }
         AutoReleaseCallbacksMap.Remove((UObject*) ObjectBase);
     }
+
+    if (NumDeleteFilterTracked() == TrackedBefore)
+    {
+        ++DeleteFilterStats.FalsePositives;
+    }
 }
 
 void FJsEnvImpl::TryReleaseType(UStruct* Struct)
@@ -2137,6 +2302,63 @@ void FJsEnvImpl::TryReleaseType(UStruct* Struct)
     TypeToTemplateInfoMap.Remove(Struct);
 }
 
+void FJsEnvImpl::AddToDeleteFilter(const void* Ptr)
+{
+    if (DeleteFilter.NeedRebuild())
+    {
+        RebuildDeleteFilter();
+    }
+    DeleteFilter.Add(Ptr);
+}
+
+void FJsEnvImpl::RebuildDeleteFilter()
+{
+    DeleteFilter.Reset(NumDeleteFilterTracked());
+    ++DeleteFilterStats.Rebuilds;
+
+    for (auto& KV : ObjectMap)
+    {
+        DeleteFilter.Add(KV.Key);
+    }
+    for (auto& KV : TypeToTemplateInfoMap)
+    {
+        DeleteFilter.Add(KV.Key);
+    }
+#if !defined(ENGINE_INDEPENDENT_JSENV)
+    for (auto& KV : BindInfoMap)
+    {
+        DeleteFilter.Add(KV.Key);
+    }
+#endif
+    for (auto Class : GeneratedClasses)
+    {
+        DeleteFilter.Add(Class);
+    }
+    for (auto& KV : TsFunctionMap)
+    {
+        DeleteFilter.Add(KV.Key);
+    }
+    for (auto& KV : MixinFunctionMap)
+    {
+        DeleteFilter.Add(KV.Key);
+    }
+    for (auto& KV : AutoReleaseCallbacksMap)
+    {
+        DeleteFilter.Add(KV.Key);
+    }
+    ContainerMeta.ForEachElementType([this](const UField* Field) { DeleteFilter.Add(Field); });
+}
+
+int32 FJsEnvImpl::NumDeleteFilterTracked() const
+{
+    return ObjectMap.Num() + TypeToTemplateInfoMap.Num() +
+#if !defined(ENGINE_INDEPENDENT_JSENV)
+           BindInfoMap.Num() +
+#endif
+           GeneratedClasses.Num() + TsFunctionMap.Num() + MixinFunctionMap.Num() + AutoReleaseCallbacksMap.Num() +
+           ContainerMeta.NumElementTypes();
+}
+
 // fix ScriptCore.cpp UObject::SkipFunction crash when Function has no parameters
 static void SkipFunction(FFrame& Stack, RESULT_DECL, UFunction* Function)
 {
@@ -2542,6 +2764,7 @@ FScriptDelegate FJsEnvImpl::NewDelegate(v8::Isolate* Isolate, v8::Local<v8::Cont
     if (Owner)
     {
         TArray<TWeakObjectPtr<UDynamicDelegateProxy>>& Callbacks = AutoReleaseCallbacksMap.FindOrAdd(Owner);
+        AddToDeleteFilter(Owner);
 
         DelegateProxy = NewObject<UDynamicDelegateProxy>();
 #ifdef THREAD_SAFE
@@ -3109,6 +3332,7 @@ FJsEnvImpl::FTemplateInfo* FJsEnvImpl::GetTemplateInfoOfType(UStruct* InStruct,
         }
 
         Existed = false;
+        AddToDeleteFilter(InStruct);
         return &TypeToTemplateInfoMap.Add(InStruct, {v8::UniquePersistent<v8::FunctionTemplate>(Isolate, Template), StructWrapper});
     }
     else
@@ -3396,6 +3620,7 @@ bool FJsEnvImpl::GetContainerTypeProperty(v8::Local<v8::Context> Context, v8::Lo
     else if (auto Field = Cast<UField>(FV8Utils::GetUObject(Context, Value)))
     {
         *PropertyPtr = ContainerMeta.GetObjectProperty(Field);
+        AddToDeleteFilter(Field);
         return *PropertyPtr != nullptr;
     }
     else
@@ -4100,10 +4325,10 @@ void FJsEnvImpl::SetTimeout(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     CHECK_V8_ARGS(EArgFunction, EArgNumber);
 
-    SetFTickerDelegate(Info, false);
+    AddTimer(Info, false);
 }
 
-void FJsEnvImpl::SetFTickerDelegate(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue)
+void FJsEnvImpl::AddTimer(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -4115,19 +4340,26 @@ void FJsEnvImpl::SetFTickerDelegate(const v8::FunctionCallbackInfo<v8::Value>& I
     FTimerInfo& TimerInfo = TimerInfos.Emplace(DelegateHandleId, FTimerInfo());
     TimerInfo.Callback.Reset(Isolate, v8::Local<v8::Function>::Cast(Info[0]));
 
-    float Millisecond = Info[1]->NumberValue(Context).ToChecked();
-    float Delay = Millisecond / 1000.f;
+    double Millisecond = Info[1]->NumberValue(Context).ToChecked();
+    // NaN和负数按0处理，超大值截断到时间轮会重新放置的范围内
+    int64_t Delay = Millisecond > 0 ? static_cast<int64_t>(FMath::Min(FMath::CeilToDouble(Millisecond), 1e15)) : 0;
 
-    TimerInfo.TickerHandle =
-        FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this, DelegateHandleId, Continue](float)
-                                                 { return this->TimerCallback(DelegateHandleId, Continue); }),
-            Delay);
+    TimerWheel.Add(DelegateHandleId, TimerNowMilliseconds(), Delay, Continue);
 
     Info.GetReturnValue().Set(DelegateHandleId);
 }
 
-bool FJsEnvImpl::TimerCallback(int DelegateHandleId, bool Continue)
+bool FJsEnvImpl::TickTimers(float DeltaTime)
 {
+    int64_t Now = TimerNowMilliseconds();
+    ExpiredTimers.clear();
+    TimerWheel.Advance(Now, ExpiredTimers);
+    if (ExpiredTimers.empty())
+    {
+        TimerStats.LastTickMilliseconds = 0;
+        return true;
+    }
+
     v8::Isolate* Isolate = MainIsolate;
 #ifdef SINGLE_THREAD_VERIFY
     ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
@@ -4141,44 +4373,190 @@ bool FJsEnvImpl::TimerCallback(int DelegateHandleId, bool Continue)
     v8::Local<v8::Context> Context = DefaultContext.Get(Isolate);
     v8::Context::Scope ContextScope(Context);
 
-    FTimerInfo* PTimeInfo = TimerInfos.Find(DelegateHandleId);
-    if (!PTimeInfo)
+    double Begin = FPlatformTime::Seconds();
+    for (uint32_t DelegateHandleId : ExpiredTimers)
     {
-        Logger->Warn(FString::Printf(TEXT("Try to callback a invalid timer: %d"), DelegateHandleId));
-        return false;
-    }
+        // 可能已经被同一批里前面的回调clear掉
+        FTimerInfo* PTimeInfo = TimerInfos.Find(DelegateHandleId);
+        if (!PTimeInfo)
+        {
+            continue;
+        }
 
-    auto OriginHandle = PTimeInfo->TickerHandle;
-    v8::Local<v8::Function> Function = TimerInfos[DelegateHandleId].Callback.Get(Isolate);
+        v8::HandleScope CallbackScope(Isolate);
+        v8::Local<v8::Function> Function = PTimeInfo->Callback.Get(Isolate);
 
-    v8::TryCatch TryCatch(Isolate);
-    (void) (Function->Call(Context, Context->Global(), 0, nullptr));
+        v8::TryCatch TryCatch(Isolate);
+        (void) (Function->Call(Context, Context->Global(), 0, nullptr));
+        ++TimerStats.Callbacks;
 
-    if (TryCatch.HasCaught())
+        if (TryCatch.HasCaught())
+        {
+            FString Message =
+                FString::Printf(TEXT("Exception in Timer Callback: %s"), *(FV8Utils::TryCatchToString(Isolate, &TryCatch)));
+            Logger->Error(Message);
+        }
+
+        // 回调里clear掉的不用再处理，setInterval从本帧开始重新计时
+        if (TimerInfos.Contains(DelegateHandleId) && !TimerWheel.Rearm(DelegateHandleId, Now))
+        {
+            RemoveTimer(DelegateHandleId);
+        }
+    }
+    TimerStats.LastTickMilliseconds = (FPlatformTime::Seconds() - Begin) * 1000.0;
+    TimerStats.MaxTickMilliseconds = FMath::Max(TimerStats.MaxTickMilliseconds, TimerStats.LastTickMilliseconds);
+
+    return true;
+}
+
+void FJsEnvImpl::RemoveTimer(int DelegateHandleId)
+{
+    if (!TimerInfos.Contains(DelegateHandleId))
     {
-        FString Message =
-            FString::Printf(TEXT("Exception in Timer Callback: %s"), *(FV8Utils::TryCatchToString(Isolate, &TryCatch)));
-        Logger->Error(Message);
+        return;
     }
+    TimerWheel.Remove(DelegateHandleId);
+    TimerInfos.Remove(DelegateHandleId);
+}
 
-    auto ClearInCallback = !TimerInfos.Contains(DelegateHandleId) || (OriginHandle != TimerInfos[DelegateHandleId].TickerHandle);
+void FJsEnvImpl::GetTimerStatistics(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
-    if (!Continue && !ClearInCallback)
+    v8::Local<v8::Object> Result = v8::Object::New(Isolate);
+    Result->Set(Context, FV8Utils::ToV8String(Isolate, "active"), v8::Integer::New(Isolate, TimerWheel.Num())).Check();
+    Result
+        ->Set(Context, FV8Utils::ToV8String(Isolate, "callbacks"),
+            v8::Number::New(Isolate, static_cast<double>(TimerStats.Callbacks)))
+        .Check();
+    Result
+        ->Set(Context, FV8Utils::ToV8String(Isolate, "last_tick_ms"), v8::Number::New(Isolate, TimerStats.LastTickMilliseconds))
+        .Check();
+    Result->Set(Context, FV8Utils::ToV8String(Isolate, "max_tick_ms"), v8::Number::New(Isolate, TimerStats.MaxTickMilliseconds))
+        .Check();
+    Info.GetReturnValue().Set(Result);
+}
+
+void FJsEnvImpl::GetUObjectDeleteFilterStatistics(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    v8::Local<v8::Object> Result = v8::Object::New(Isolate);
+    auto SetNumber = [&](const char* Name, uint64_t Value)
+    { Result->Set(Context, FV8Utils::ToV8String(Isolate, Name), v8::Number::New(Isolate, static_cast<double>(Value))).Check(); };
+    SetNumber("checks", DeleteFilterStats.Checks);
+    SetNumber("rejected", DeleteFilterStats.Rejected);
+    SetNumber("passed", DeleteFilterStats.Checks - DeleteFilterStats.Rejected);
+    SetNumber("false_positives", DeleteFilterStats.FalsePositives);
+    SetNumber("rebuilds", DeleteFilterStats.Rebuilds);
+    SetNumber("tracked", NumDeleteFilterTracked());
+    Info.GetReturnValue().Set(Result);
+
+    // 传true时读完清零，方便按关卡流送区间统计
+    if (Info.Length() > 0 && Info[0]->BooleanValue(Isolate))
     {
-        RemoveFTickerDelegateHandle(DelegateHandleId);
+        DeleteFilterStats = FDeleteFilterStats();
     }
+}
 
-    return Continue && !ClearInCallback;
+#if !defined(ENGINE_INDEPENDENT_JSENV)
+void FJsEnvImpl::GetTryBindJsStatistics(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    uint64 Created, Bound, Rejected;
+    FJsEnvGroup::GetTryBindJsStatistics(Created, Bound, Rejected);
+
+    v8::Local<v8::Object> Result = v8::Object::New(Isolate);
+    auto SetNumber = [&](const char* Name, uint64_t Value)
+    { Result->Set(Context, FV8Utils::ToV8String(Isolate, Name), v8::Number::New(Isolate, static_cast<double>(Value))).Check(); };
+    SetNumber("created", Created);
+    SetNumber("bound", Bound);
+    SetNumber("rejected", Rejected);
+    Info.GetReturnValue().Set(Result);
 }
+#endif
 
-void FJsEnvImpl::RemoveFTickerDelegateHandle(int DelegateHandleId)
+void FJsEnvImpl::SetFunctionProfile(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
-    if (!TimerInfos.Contains(DelegateHandleId))
+    v8::Isolate* Isolate = Info.GetIsolate();
+
+    FFunctionTranslator::SetProfileEnabled(Info[0]->BooleanValue(Isolate));
+}
+
+void FJsEnvImpl::GetFunctionProfile(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    TArray<FFunctionCallProfile> Records;
+    FFunctionTranslator::GetProfileRecords(Records);
+
+    v8::Local<v8::Array> Result = v8::Array::New(Isolate, Records.Num());
+    for (int32 i = 0; i < Records.Num(); ++i)
+    {
+        v8::Local<v8::Object> Record = v8::Object::New(Isolate);
+        Record
+            ->Set(Context, FV8Utils::ToV8String(Isolate, "name"),
+                FV8Utils::ToV8String(Isolate, Records[i].Function->GetPathName()))
+            .Check();
+        Record->Set(Context, FV8Utils::ToV8String(Isolate, "calls"), v8::Number::New(Isolate, static_cast<double>(Records[i].Calls)))
+            .Check();
+        Record->Set(Context, FV8Utils::ToV8String(Isolate, "total_ms"), v8::Number::New(Isolate, Records[i].Seconds * 1000.0))
+            .Check();
+        Result->Set(Context, i, Record).Check();
+    }
+    Info.GetReturnValue().Set(Result);
+}
+
+// benchmarkMergeObject(des, src, iterations?)：同样的参数分别按字段、按js对象的key（旧实现）merge多次，返回耗时
+void FJsEnvImpl::BenchmarkMergeObject(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Isolate::Scope Isolatescope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+    v8::Context::Scope ContextScope(Context);
+
+    CHECK_V8_ARGS(EArgObject, EArgObject);
+
+    auto Des = Info[0]->ToObject(Context).ToLocalChecked();
+    auto Src = Info[1]->ToObject(Context).ToLocalChecked();
+    int32 Iterations = Info.Length() > 2 && Info[2]->IsInt32() ? Info[2]->Int32Value(Context).ToChecked() : 100000;
+    UStruct* DesType = nullptr;
+    void* DesPtr = nullptr;
+    if (!GetMergeTarget(Isolate, Des, DesType, DesPtr))
     {
         return;
     }
-    FUETicker::GetCoreTicker().RemoveTicker(TimerInfos[DelegateHandleId].TickerHandle);
-    TimerInfos.Remove(DelegateHandleId);
+
+    ObjectMerger* Merger = GetObjectMerger(DesType).get();
+    auto Run = [&](ObjectMerger::EMergeMode Mode)
+    {
+        double Begin = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            v8::HandleScope LoopScope(Isolate);
+            Merger->Merge(Isolate, Context, Src, DesPtr, Mode);
+        }
+        return (FPlatformTime::Seconds() - Begin) * 1000.0;
+    };
+    // 先各跑一遍，把嵌套字段的merger建好
+    Merger->Merge(Isolate, Context, Src, DesPtr, ObjectMerger::EMergeMode::ByField);
+    Merger->Merge(Isolate, Context, Src, DesPtr, ObjectMerger::EMergeMode::ByName);
+    double ByFieldMilliseconds = Run(ObjectMerger::EMergeMode::ByField);
+    double ByNameMilliseconds = Run(ObjectMerger::EMergeMode::ByName);
+
+    v8::Local<v8::Object> Result = v8::Object::New(Isolate);
+    Result->Set(Context, FV8Utils::ToV8String(Isolate, "iterations"), v8::Integer::New(Isolate, Iterations)).Check();
+    Result->Set(Context, FV8Utils::ToV8String(Isolate, "fields"), v8::Integer::New(Isolate, static_cast<int32>(Merger->Fields.size())))
+        .Check();
+    Result->Set(Context, FV8Utils::ToV8String(Isolate, "by_field_ms"), v8::Number::New(Isolate, ByFieldMilliseconds)).Check();
+    Result->Set(Context, FV8Utils::ToV8String(Isolate, "by_name_ms"), v8::Number::New(Isolate, ByNameMilliseconds)).Check();
+    Info.GetReturnValue().Set(Result);
 }
 
 void FJsEnvImpl::ClearInterval(const v8::FunctionCallbackInfo<v8::Value>& Info)
@@ -4200,7 +4578,7 @@ void FJsEnvImpl::ClearInterval(const v8::FunctionCallbackInfo<v8::Value>& Info)
     {
         CHECK_V8_ARGS(EArgInt32);
         int HandleId = Info[0]->Int32Value(Context).ToChecked();
-        RemoveFTickerDelegateHandle(HandleId);
+        RemoveTimer(HandleId);
     }
 }
 
@@ -4214,7 +4592,7 @@ void FJsEnvImpl::SetInterval(const v8::FunctionCallbackInfo<v8::Value>& Info)
 
     CHECK_V8_ARGS(EArgFunction, EArgNumber);
 
-    SetFTickerDelegate(Info, true);
+    AddTimer(Info, true);
 }
 
 #if !defined(ENGINE_INDEPENDENT_JSENV)
@@ -4299,6 +4677,7 @@ void FJsEnvImpl::MakeUClass(const v8::FunctionCallbackInfo<v8::Value>& Info)
     if (!GeneratedClasses.Contains(Class))
     {
         GeneratedClasses.Add(Class);
+        AddToDeleteFilter(Class);
     }
     SysObjectRetainer.Retain(Class);
 
@@ -4395,6 +4774,7 @@ void FJsEnvImpl::Mixin(const v8::FunctionCallbackInfo<v8::Value>& Info)
             auto MixinedFunc = UJSGeneratedClass::Mixin(Isolate, New, Function, MixinInvoker, TakeJsObjectRef, !NoWarning);
             MixinFunctionMap.Emplace(
                 MixinedFunc, v8::UniquePersistent<v8::Function>(Isolate, v8::Local<v8::Function>::Cast(JsFunc)));
+            AddToDeleteFilter(MixinedFunc);
             ReplaceMethodNames.Add(MethodName);
         }
     }
@@ -22,6 +22,8 @@
 #include "UECompatible.h"
 #include "ContainerMeta.h"
 #include "ObjectCacheNode.h"
+#include "TimerWheel.h"
+#include "ObjectDeleteFilter.h"
 #include <unordered_map>
 
 #if ENGINE_MINOR_VERSION >= 25 || ENGINE_MAJOR_VERSION > 4
@@ -270,6 +272,14 @@ public:
 
     void TryReleaseType(UStruct* Struct);
 
+    // 记录到NotifyUObjectDeleted的过滤器，用于所有删除时需要清理的容器的插入点
+    void AddToDeleteFilter(const void* Ptr);
+
+    void RebuildDeleteFilter();
+
+    // NotifyUObjectDeleted会清理的各个容器的元素总数
+    int32 NumDeleteFilterTracked() const;
+
 private:
     bool LoadFile(const FString& RequiringDir, const FString& ModuleName, FString& OutPath, FString& OutDebugPath,
         TArray<uint8>& Data, FString& ErrInfo);
@@ -314,11 +324,12 @@ private:
 
     void SetTimeout(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
-    void SetFTickerDelegate(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue);
+    void AddTimer(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue);
 
-    bool TimerCallback(int DelegateHandleId, bool Continue);
+    // 所有定时器共用的ticker，每帧推进一次时间轮并批量执行到期回调
+    bool TickTimers(float DeltaTime);
 
-    void RemoveFTickerDelegateHandle(int HandleId);
+    void RemoveTimer(int HandleId);
 
     void SetInterval(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
@@ -326,6 +337,9 @@ private:
 
     void MergeObject(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+    // 取merge的目标（UStruct和内存地址），失败时抛js异常并返回false
+    bool GetMergeTarget(v8::Isolate* Isolate, v8::Local<v8::Object> Des, UStruct*& OutStruct, void*& OutPtr);
+
     void NewObjectByClass(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
     void NewStructByScriptStruct(const v8::FunctionCallbackInfo<v8::Value>& Info);
@@ -341,6 +355,20 @@ private:
 
     void DumpStatisticsLog(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+    void GetTimerStatistics(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    void GetUObjectDeleteFilterStatistics(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+#if !defined(ENGINE_INDEPENDENT_JSENV)
+    void GetTryBindJsStatistics(const v8::FunctionCallbackInfo<v8::Value>& Info);
+#endif
+
+    void SetFunctionProfile(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    void GetFunctionProfile(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    void BenchmarkMergeObject(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
     void SetInspectorCallback(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
     void DispatchProtocolMessage(const v8::FunctionCallbackInfo<v8::Value>& Info);
@@ -372,73 +400,38 @@ private:
 
     struct ObjectMerger
     {
-        std::map<std::string, std::unique_ptr<FPropertyTranslator>> Fields;
+        enum class EMergeMode
+        {
+            Auto,
+            ByField,    // 遍历UStruct的字段，用预先创建好的key去js对象上Get
+            ByName      // 遍历js对象的key，转utf8后查表（原来的实现）
+        };
+
+        // 字段多于这个数时js对象一般只填了少数几个字段，按js对象的key来查更快
+        static const size_t kMaxFieldDrivenFields = 32;
+
+        struct FField
+        {
+            v8::Global<v8::String> Key;
+            std::unique_ptr<FPropertyTranslator> Translator;
+            // 字段是UObject或者UStruct时，js传的普通对象要递归merge
+            UStruct* FieldStruct = nullptr;
+            ObjectMerger* FieldMerger = nullptr;
+        };
+
+        std::vector<FField> Fields;
+        std::map<std::string, size_t> FieldIndexByName;
         UStruct* Struct;
         FJsEnvImpl* Parent;
 
-        ObjectMerger(FJsEnvImpl* InParent, UStruct* InStruct)
-        {
-            Parent = InParent;
-            Struct = InStruct;
-            for (TFieldIterator<PropertyMacro> It(Struct); It; ++It)
-            {
-                PropertyMacro* Property = *It;
-                TStringConversion<TStringConvert<TCHAR, ANSICHAR>> Name(*Property->GetName());
-                Fields[Name.Get()] = FPropertyTranslator::Create(Property);
-            }
-        }
+        ObjectMerger(FJsEnvImpl* InParent, UStruct* InStruct);
 
-        void Merge(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Object> JsObject, void* Ptr)
-        {
-            if (auto Class = Cast<UClass>(Struct))
-            {
-                UObject* Object = reinterpret_cast<UObject*>(Ptr);
-                if (!Object->IsValidLowLevel() || UEObjectIsPendingKill(Object) || Object->GetClass() != Class ||
-                    FV8Utils::GetPointer(JsObject))
-                {
-                    return;
-                }
-            }
-            auto Keys = JsObject->GetOwnPropertyNames(Context).ToLocalChecked();
-            for (decltype(Keys->Length()) i = 0; i < Keys->Length(); ++i)
-            {
-                auto Key = Keys->Get(Context, i).ToLocalChecked();
-                auto Iter = Fields.find(*v8::String::Utf8Value(Isolate, Key));
-                if (Iter != Fields.end())
-                {
-                    auto MaybeValue = JsObject->Get(Context, Key);
-                    if (!MaybeValue.IsEmpty())
-                    {
-                        auto Value = MaybeValue.ToLocalChecked();
-                        if (Value->IsObject())
-                        {
-                            auto JsObjectField = Value->ToObject(Context).ToLocalChecked();
-                            if (!FV8Utils::GetPointerFast<void>(JsObjectField))
-                            {
-                                UStruct* FieldStruct = nullptr;
-                                if (auto ObjectPropertyBase = CastFieldMacro<ObjectPropertyBaseMacro>(Iter->second->Property))
-                                {
-                                    FieldStruct = ObjectPropertyBase->PropertyClass;
-                                }
-                                else if (auto StructProperty = CastFieldMacro<StructPropertyMacro>(Iter->second->Property))
-                                {
-                                    FieldStruct = StructProperty->Struct;
-                                }
-                                if (FieldStruct)
-                                {
-                                    Parent->GetObjectMerger(FieldStruct)
-                                        ->Merge(Isolate, Context, JsObjectField,
-                                            Iter->second->Property->ContainerPtrToValuePtr<void>(Ptr));
-                                }
-                                continue;
-                            }
-                        }
-                        if (!Value->IsUndefined())
-                            Iter->second->JsToUEInContainer(Isolate, Context, Value, Ptr, true);
-                    }
-                }
-            }
-        }
+        void Merge(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Object> JsObject, void* Ptr,
+            EMergeMode Mode = EMergeMode::Auto);
+
+    private:
+        void MergeField(v8::Isolate* Isolate, v8::Local<v8::Context> Context, FField& Field, v8::Local<v8::Value> Value, void* Ptr,
+            EMergeMode Mode);
     };
 
     friend ObjectMerger;
@@ -703,11 +696,39 @@ private:
     struct FTimerInfo
     {
         v8::Global<v8::Function> Callback;
-        FUETickDelegateHandle TickerHandle;
     };
     uint32_t TimerID = 0;
     TMap<uint32_t, FTimerInfo> TimerInfos;
 
+    FTimerWheel TimerWheel;
+
+    // TickTimers复用，避免每帧分配
+    std::vector<uint32_t> ExpiredTimers;
+
+    FUETickDelegateHandle TimerTickerHandle;
+
+    struct FTimerStats
+    {
+        uint64_t Callbacks = 0;
+        // 最近一次和历史最长的单帧回调耗时
+        double LastTickMilliseconds = 0;
+        double MaxTickMilliseconds = 0;
+    };
+    FTimerStats TimerStats;
+
+    FObjectDeleteFilter DeleteFilter;
+
+    struct FDeleteFilterStats
+    {
+        uint64_t Checks = 0;
+        // 被过滤器直接排除的删除通知
+        uint64_t Rejected = 0;
+        // 通过了过滤器但实际上没有需要清理的内容
+        uint64_t FalsePositives = 0;
+        uint64_t Rebuilds = 0;
+    };
+    FDeleteFilterStats DeleteFilterStats;
+
     FUETickDelegateHandle DelegateProxiesCheckerHandler;
 
     V8Inspector* Inspector;
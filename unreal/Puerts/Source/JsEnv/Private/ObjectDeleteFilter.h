@@ -0,0 +1,88 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+#include "NamespaceDef.h"
+
+namespace PUERTS_NAMESPACE
+{
+// NotifyUObjectDeleted的快速过滤：js见过的UObject/UStruct指针都记录到一个2^20位的位图(每个指针2个hash位)
+// 只置位不清位，不会漏判，误判时走原来的完整清理流程；已删除对象的位残留越来越多时由调用者清空后按现存对象重建
+class FObjectDeleteFilter
+{
+public:
+    static const int kBitsShift = 20;
+    static const uint64_t kBits = static_cast<uint64_t>(1) << kBitsShift;
+
+    FObjectDeleteFilter() : Words(kBits / 64, 0)
+    {
+    }
+
+    void Add(const void* Ptr)
+    {
+        uint64_t Hash = HashPointer(Ptr);
+        SetBit(Hash & (kBits - 1));
+        SetBit((Hash >> 32) & (kBits - 1));
+        ++Inserted;
+    }
+
+    bool MayContain(const void* Ptr) const
+    {
+        uint64_t Hash = HashPointer(Ptr);
+        return TestBit(Hash & (kBits - 1)) && TestBit((Hash >> 32) & (kBits - 1));
+    }
+
+    // 上次重建后插入次数超过阈值，误判率开始上升
+    bool NeedRebuild() const
+    {
+        return Inserted > RebuildThreshold;
+    }
+
+    // 重建前调用，LiveCount为重建时要重新加入的指针数，用于推迟下次重建，避免存活对象很多时频繁重建
+    void Reset(uint64_t LiveCount)
+    {
+        std::fill(Words.begin(), Words.end(), 0);
+        Inserted = 0;
+        RebuildThreshold = std::max(kBits / 8, LiveCount * 2);
+    }
+
+private:
+    static uint64_t HashPointer(const void* Ptr)
+    {
+        // murmur3 fmix64
+        uint64_t Hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(Ptr));
+        Hash ^= Hash >> 33;
+        Hash *= 0xff51afd7ed558ccdULL;
+        Hash ^= Hash >> 33;
+        Hash *= 0xc4ceb9fe1a85ec53ULL;
+        Hash ^= Hash >> 33;
+        return Hash;
+    }
+
+    void SetBit(uint64_t Bit)
+    {
+        Words[Bit >> 6] |= static_cast<uint64_t>(1) << (Bit & 63);
+    }
+
+    bool TestBit(uint64_t Bit) const
+    {
+        return (Words[Bit >> 6] & (static_cast<uint64_t>(1) << (Bit & 63))) != 0;
+    }
+
+    std::vector<uint64_t> Words;
+
+    uint64_t Inserted = 0;
+
+    uint64_t RebuildThreshold = kBits / 8;
+};
+}    // namespace PUERTS_NAMESPACE
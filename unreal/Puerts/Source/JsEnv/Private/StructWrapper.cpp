@@ -191,6 +191,10 @@ v8::Local<v8::FunctionTemplate> FStructWrapper::ToFunctionTemplate(v8::Isolate*
     {
         ExternalInitialize = (V8InitializeFuncType) ClassDefinition->Initialize;
         ExternalFinalize = ClassDefinition->Finalize;
+#ifdef WITH_V8_FAST_CALL
+        // 重载的ReflectionInfo为空，从MethodInfos/FunctionInfos里收集同名的fast call
+        std::vector<v8::CFunction> FastCallOverloads;
+#endif
         JSFunctionInfo* FunctionInfo = ClassDefinition->Methods;
         while (FunctionInfo && FunctionInfo->Name && FunctionInfo->Callback)
         {
@@ -208,6 +212,17 @@ v8::Local<v8::FunctionTemplate> FStructWrapper::ToFunctionTemplate(v8::Isolate*
                             v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
                             FastCallInfo));
                 }
+#ifdef WITH_V8_FAST_CALL
+                else if (CollectFastCallOverloads(ClassDefinition->MethodInfos, FunctionInfo->Name, FastCallOverloads))
+                {
+                    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, FunctionInfo->Name),
+                        v8::FunctionTemplate::NewWithCFunctionOverloads(Isolate, (v8::FunctionCallback) FunctionInfo->Callback,
+                            FunctionInfo->Data ? static_cast<v8::Local<v8::Value>>(v8::External::New(Isolate, FunctionInfo->Data))
+                                               : v8::Local<v8::Value>(),
+                            v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
+                            v8::MemorySpan<const v8::CFunction>(FastCallOverloads.data(), FastCallOverloads.size())));
+                }
+#endif
                 else
 #endif
                 {
@@ -236,6 +251,17 @@ v8::Local<v8::FunctionTemplate> FStructWrapper::ToFunctionTemplate(v8::Isolate*
                             v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
                             FastCallInfo));
                 }
+#ifdef WITH_V8_FAST_CALL
+                else if (CollectFastCallOverloads(ClassDefinition->FunctionInfos, FunctionInfo->Name, FastCallOverloads))
+                {
+                    Result->Set(FV8Utils::InternalString(Isolate, FunctionInfo->Name),
+                        v8::FunctionTemplate::NewWithCFunctionOverloads(Isolate, (v8::FunctionCallback) FunctionInfo->Callback,
+                            FunctionInfo->Data ? static_cast<v8::Local<v8::Value>>(v8::External::New(Isolate, FunctionInfo->Data))
+                                               : v8::Local<v8::Value>(),
+                            v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
+                            v8::MemorySpan<const v8::CFunction>(FastCallOverloads.data(), FastCallOverloads.size())));
+                }
+#endif
                 else
 #endif
                 {
@@ -0,0 +1,76 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "ContainerWrapper.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// CopyFrom的源数据是本容器自己的view时(arr.CopyFrom(arr.View().subarray(...)))，缩容可能重新分配内存，
+// 拷贝必须发生在缩容之前
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPuertsArrayAssignBytesTest, "Puerts.ContainerWrapper.CopyFromSelfView",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPuertsArrayAssignBytesTest::RunTest(const FString& Parameters)
+{
+    const int32 Num = 4096;
+    const int32 ElementSize = sizeof(int32);
+
+    // 大数组缩成1个元素，源数据在将被释放的旧内存中间
+    {
+        TArray<int32> Values;
+        for (int32 i = 0; i < Num; ++i)
+        {
+            Values.Add(i);
+        }
+        FScriptArray* ScriptArray = reinterpret_cast<FScriptArray*>(&Values);
+        const uint8* Source = reinterpret_cast<const uint8*>(Values.GetData() + 10);
+        PUERTS_NAMESPACE::FScriptArrayWrapper::AssignBytes(ScriptArray, ElementSize, Source, 1);
+        TestEqual(TEXT("shrink to one: Num"), Values.Num(), 1);
+        TestEqual(TEXT("shrink to one: value"), Values[0], 10);
+    }
+
+    // 源数据和目标重叠：整体前移一个元素
+    {
+        TArray<int32> Values;
+        for (int32 i = 0; i < Num; ++i)
+        {
+            Values.Add(i);
+        }
+        FScriptArray* ScriptArray = reinterpret_cast<FScriptArray*>(&Values);
+        const uint8* Source = reinterpret_cast<const uint8*>(Values.GetData() + 1);
+        PUERTS_NAMESPACE::FScriptArrayWrapper::AssignBytes(ScriptArray, ElementSize, Source, Num - 1);
+        TestEqual(TEXT("overlap: Num"), Values.Num(), Num - 1);
+        bool Match = true;
+        for (int32 i = 0; i < Num - 1 && Match; ++i)
+        {
+            Match = Values[i] == i + 1;
+        }
+        TestTrue(TEXT("overlap: values"), Match);
+    }
+
+    // 外部数据扩容
+    {
+        TArray<int32> Values;
+        Values.Add(-1);
+        TArray<int32> External;
+        for (int32 i = 0; i < Num; ++i)
+        {
+            External.Add(i * 2);
+        }
+        FScriptArray* ScriptArray = reinterpret_cast<FScriptArray*>(&Values);
+        PUERTS_NAMESPACE::FScriptArrayWrapper::AssignBytes(
+            ScriptArray, ElementSize, reinterpret_cast<const uint8*>(External.GetData()), Num);
+        TestTrue(TEXT("grow: values"), Values == External);
+    }
+
+    return true;
+}
+
+#endif    // WITH_DEV_AUTOMATION_TESTS
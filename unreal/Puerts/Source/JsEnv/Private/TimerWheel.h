@@ -0,0 +1,269 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "NamespaceDef.h"
+
+namespace PUERTS_NAMESPACE
+{
+// setTimeout/setInterval用的分层时间轮，精度1ms
+// 4层、每层64个槽，第n层一个槽覆盖64^n毫秒，总共覆盖约4.6小时，更远的定时器先挂在最高层，降级时按真实到期时间重新放置
+// 增删都是O(1)，Advance按毫秒推进，到期的定时器按到期顺序一次性交给调用者，回调执行完后周期定时器通过Rearm重新挂上
+// 不加锁，只在js线程使用
+class FTimerWheel
+{
+public:
+    static const int kSlotBits = 6;
+    static const int kSlots = 1 << kSlotBits;
+    static const int kLevels = 4;
+    static const int64_t kMaxRange = (static_cast<int64_t>(1) << (kSlotBits * kLevels)) - 1;
+
+    explicit FTimerWheel(int64_t NowMilliseconds = 0) : Base(NowMilliseconds)
+    {
+        for (int i = 0; i < kLevels * kSlots; ++i)
+        {
+            Heads[i] = -1;
+            Tails[i] = -1;
+        }
+    }
+
+    // Repeat为true时到期后可以通过Rearm以DelayMilliseconds为周期重新挂上
+    void Add(uint32_t Id, int64_t NowMilliseconds, int64_t DelayMilliseconds, bool Repeat)
+    {
+        Remove(Id);
+        // 轮上是空的，直接跳到当前时间，避免Advance补走空转的毫秒
+        if (Linked == 0 && NowMilliseconds > Base)
+        {
+            Base = NowMilliseconds;
+        }
+        int32_t Index = AllocateNode();
+        FNode& Node = Nodes[Index];
+        Node.Id = Id;
+        Node.Interval = DelayMilliseconds < 0 ? 0 : DelayMilliseconds;
+        Node.Repeat = Repeat;
+        Node.Expire = NowMilliseconds + Node.Interval;
+        IdToNode[Id] = Index;
+        Link(Index);
+    }
+
+    // 已经到期、正在等回调的定时器也可以删除
+    bool Remove(uint32_t Id)
+    {
+        auto Iter = IdToNode.find(Id);
+        if (Iter == IdToNode.end())
+        {
+            return false;
+        }
+        int32_t Index = Iter->second;
+        IdToNode.erase(Iter);
+        Unlink(Index);
+        FreeNode(Index);
+        return true;
+    }
+
+    bool Contains(uint32_t Id) const
+    {
+        return IdToNode.find(Id) != IdToNode.end();
+    }
+
+    // 周期定时器从NowMilliseconds开始重新计时并返回true，一次性定时器返回false，由调用者Remove
+    bool Rearm(uint32_t Id, int64_t NowMilliseconds)
+    {
+        auto Iter = IdToNode.find(Id);
+        if (Iter == IdToNode.end())
+        {
+            return false;
+        }
+        FNode& Node = Nodes[Iter->second];
+        if (!Node.Repeat)
+        {
+            return false;
+        }
+        Unlink(Iter->second);
+        Node.Expire = NowMilliseconds + Node.Interval;
+        Link(Iter->second);
+        return true;
+    }
+
+    // 推进到NowMilliseconds(含)，到期定时器的Id追加到OutExpired，定时器本身保留到Rearm或Remove
+    void Advance(int64_t NowMilliseconds, std::vector<uint32_t>& OutExpired)
+    {
+        if (Linked == 0)
+        {
+            if (NowMilliseconds >= Base)
+            {
+                Base = NowMilliseconds + 1;
+            }
+            return;
+        }
+        while (Base <= NowMilliseconds)
+        {
+            int Slot = static_cast<int>(Base & (kSlots - 1));
+            if (Slot == 0)
+            {
+                for (int Level = 1; Level < kLevels && Cascade(Level) == 0; ++Level)
+                {
+                }
+            }
+            for (int32_t Index = Heads[Slot]; Index >= 0;)
+            {
+                int32_t Next = Nodes[Index].Next;
+                Unlink(Index);
+                OutExpired.push_back(Nodes[Index].Id);
+                Index = Next;
+            }
+            ++Base;
+            if (Linked == 0 && NowMilliseconds >= Base)
+            {
+                Base = NowMilliseconds + 1;
+            }
+        }
+    }
+
+    // 还没被删除的定时器数，包括已到期等待回调的
+    int32_t Num() const
+    {
+        return static_cast<int32_t>(IdToNode.size());
+    }
+
+private:
+    struct FNode
+    {
+        uint32_t Id = 0;
+        bool Repeat = false;
+        int64_t Expire = 0;
+        int64_t Interval = 0;
+        // 所在槽位(Level * kSlots + Slot)，不在轮上时为-1
+        int32_t Bucket = -1;
+        int32_t Prev = -1;
+        int32_t Next = -1;
+    };
+
+    int32_t AllocateNode()
+    {
+        if (FreeHead >= 0)
+        {
+            int32_t Index = FreeHead;
+            FreeHead = Nodes[Index].Next;
+            Nodes[Index] = FNode();
+            return Index;
+        }
+        Nodes.emplace_back();
+        return static_cast<int32_t>(Nodes.size() - 1);
+    }
+
+    void FreeNode(int32_t Index)
+    {
+        Nodes[Index].Next = FreeHead;
+        FreeHead = Index;
+    }
+
+    void Link(int32_t Index)
+    {
+        FNode& Node = Nodes[Index];
+        // 已经过期的放到下一个要处理的槽
+        int64_t Expire = Node.Expire < Base ? Base : Node.Expire;
+        int64_t Delta = Expire - Base;
+        if (Delta > kMaxRange)
+        {
+            Delta = kMaxRange;
+            Expire = Base + kMaxRange;
+        }
+        int Level = 0;
+        while (Level < kLevels - 1 && Delta >= (static_cast<int64_t>(1) << (kSlotBits * (Level + 1))))
+        {
+            ++Level;
+        }
+        int Slot = static_cast<int>((Expire >> (kSlotBits * Level)) & (kSlots - 1));
+        int32_t Bucket = Level * kSlots + Slot;
+
+        Node.Bucket = Bucket;
+        Node.Next = -1;
+        Node.Prev = Tails[Bucket];
+        if (Tails[Bucket] >= 0)
+        {
+            Nodes[Tails[Bucket]].Next = Index;
+        }
+        else
+        {
+            Heads[Bucket] = Index;
+        }
+        Tails[Bucket] = Index;
+        ++Linked;
+    }
+
+    void Unlink(int32_t Index)
+    {
+        FNode& Node = Nodes[Index];
+        if (Node.Bucket < 0)
+        {
+            return;
+        }
+        if (Node.Prev >= 0)
+        {
+            Nodes[Node.Prev].Next = Node.Next;
+        }
+        else
+        {
+            Heads[Node.Bucket] = Node.Next;
+        }
+        if (Node.Next >= 0)
+        {
+            Nodes[Node.Next].Prev = Node.Prev;
+        }
+        else
+        {
+            Tails[Node.Bucket] = Node.Prev;
+        }
+        Node.Bucket = -1;
+        Node.Prev = -1;
+        Node.Next = -1;
+        --Linked;
+    }
+
+    // 把Level层当前槽的定时器重新放到下层，返回该槽下标，为0说明这一层也转完一圈，需要继续处理上一层
+    int Cascade(int Level)
+    {
+        int Slot = static_cast<int>((Base >> (kSlotBits * Level)) & (kSlots - 1));
+        int32_t Bucket = Level * kSlots + Slot;
+        int32_t Index = Heads[Bucket];
+        Heads[Bucket] = -1;
+        Tails[Bucket] = -1;
+        while (Index >= 0)
+        {
+            int32_t Next = Nodes[Index].Next;
+            Nodes[Index].Bucket = -1;
+            --Linked;
+            Link(Index);
+            Index = Next;
+        }
+        return Slot;
+    }
+
+    std::vector<FNode> Nodes;
+
+    int32_t FreeHead = -1;
+
+    std::unordered_map<uint32_t, int32_t> IdToNode;
+
+    int32_t Heads[kLevels * kSlots];
+
+    int32_t Tails[kLevels * kSlots];
+
+    // 下一个要处理的毫秒
+    int64_t Base;
+
+    // 挂在轮上的定时器数
+    int32_t Linked = 0;
+};
+}    // namespace PUERTS_NAMESPACE
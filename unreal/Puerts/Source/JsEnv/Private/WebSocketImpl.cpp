@@ -44,6 +44,12 @@ THIRD_PARTY_INCLUDES_END
 PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 
 #include <sstream>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
 
 namespace PUERTS_NAMESPACE
 {
@@ -89,22 +95,40 @@ public:
 };
 #endif
 
-class V8WebSocketClientImpl
-{
-public:
-    V8WebSocketClientImpl(v8::Isolate* InIsolate, v8::Local<v8::Context> InContext, v8::Local<v8::Object> InSelf);
-
 #if defined(WITH_WEBSOCKET_SSL)
-    using wspp_client = websocketpp::client<websocketpp::config::asio_tls>;
+using wspp_client = websocketpp::client<websocketpp::config::asio_tls>;
 #else
-    using wspp_client = websocketpp::client<websocketpp::config::asio>;
+using wspp_client = websocketpp::client<websocketpp::config::asio>;
 #endif
 
-    using wspp_connection_hdl = websocketpp::connection_hdl;
+using wspp_connection_hdl = websocketpp::connection_hdl;
+
+using wspp_message_ptr = wspp_client::message_ptr;
+
+using wspp_exception = websocketpp::exception;
 
-    using wspp_message_ptr = wspp_client::message_ptr;
+class V8WebSocketClientImpl;
 
-    using wspp_exception = websocketpp::exception;
+class V8WebSocketHub;
+
+// 共享模式下一个连接在js线程和网络线程之间共享的状态
+struct V8WebSocketSharedConnection
+{
+    // 只在js线程访问，socket关闭或被gc后置空，之后到达的事件直接丢弃
+    V8WebSocketClientImpl* Owner = nullptr;
+
+    // 只在网络线程访问
+    wspp_connection_hdl Handle;
+
+    // js线程在连接建立前close时置位，由网络线程的open回调补发close
+    std::atomic<bool> Closing{false};
+};
+
+class V8WebSocketClientImpl
+{
+public:
+    V8WebSocketClientImpl(v8::Isolate* InIsolate, v8::Local<v8::Context> InContext, v8::Local<v8::Object> InSelf,
+        std::shared_ptr<V8WebSocketHub> InHub = nullptr);
 
     enum HandlerType
     {
@@ -127,6 +151,9 @@ public:
 
     void PollOne();
 
+    // 共享模式下由V8WebSocketHub::Dispatch在js线程调用
+    void OnSharedEvent(HandlerType Type, const wspp_message_ptr& Message, int CloseCode, const std::string& Reason);
+
 private:
     void OnOpen(wspp_connection_hdl Handle);
 
@@ -152,6 +179,71 @@ private:
     bool Connenting = false;
 
     v8::Global<v8::Function> Handles[HANDLE_TYPE_END];
+
+    // 非空表示共享模式，此时Client不使用
+    std::shared_ptr<V8WebSocketHub> Hub;
+
+    std::shared_ptr<V8WebSocketSharedConnection> SharedConnection;
+
+    bool SharedOpened = false;
+};
+
+// 同一个isolate里共享模式的socket共用一个websocketpp endpoint(也就是一个asio io_context)，由独立的网络线程驱动
+// 网络线程不访问v8，收到的事件压入无锁链表，js线程每tick调用WebSocketPP.dispatch()一次性取出并派发
+// 发送时在js线程直接把数据加掩码写进已经组好帧头的消息，网络线程原样写出，不再经过websocketpp的拷贝和掩码
+class V8WebSocketHub
+{
+public:
+    struct FEvent
+    {
+        std::shared_ptr<V8WebSocketSharedConnection> Connection;
+        V8WebSocketClientImpl::HandlerType Type;
+        wspp_message_ptr Message;
+        int CloseCode = 0;
+        std::string Reason;
+        FEvent* Next = nullptr;
+    };
+
+    // 不存在时创建并启动网络线程
+    static std::shared_ptr<V8WebSocketHub> Get(v8::Isolate* Isolate);
+
+    static int Dispatch(v8::Isolate* Isolate);
+
+    // 停止网络线程，isolate销毁前调用
+    static void Release(v8::Isolate* Isolate);
+
+    V8WebSocketHub();
+
+    ~V8WebSocketHub();
+
+    void Connect(std::shared_ptr<V8WebSocketSharedConnection> Connection, const std::string& Uri, websocketpp::lib::error_code& ec);
+
+    void Send(std::shared_ptr<V8WebSocketSharedConnection> Connection, wspp_message_ptr Message);
+
+    void Close(std::shared_ptr<V8WebSocketSharedConnection> Connection, websocketpp::close::status::value Code, const std::string& Reason);
+
+    // 组一个客户端数据帧(带掩码)，返回的消息可以直接交给Send
+    wspp_message_ptr PrepareFrame(websocketpp::frame::opcode::value Op, const void* Data, size_t Length);
+
+private:
+    void Shutdown();
+
+    void Push(FEvent* Event);
+
+    FEvent* PopAll();
+
+    wspp_client Client;
+
+    std::thread Thread;
+
+    // 网络线程压入、js线程整体取走，后进先出
+    std::atomic<FEvent*> Head{nullptr};
+
+    std::random_device MaskingKeyGenerator;
+
+    static std::mutex HubsMutex;
+
+    static std::map<v8::Isolate*, std::shared_ptr<V8WebSocketHub>> Hubs;
 };
 
 static void OnGarbageCollectedWithFree(const v8::WeakCallbackInfo<V8WebSocketClientImpl>& Data)
@@ -161,8 +253,9 @@ static void OnGarbageCollectedWithFree(const v8::WeakCallbackInfo<V8WebSocketCli
     delete Data.GetParameter();
 }
 
-V8WebSocketClientImpl::V8WebSocketClientImpl(v8::Isolate* InIsolate, v8::Local<v8::Context> InContext, v8::Local<v8::Object> InSelf)
-    : Isolate(InIsolate), GContext(InIsolate, InContext), GSelf(InIsolate, InSelf)
+V8WebSocketClientImpl::V8WebSocketClientImpl(
+    v8::Isolate* InIsolate, v8::Local<v8::Context> InContext, v8::Local<v8::Object> InSelf, std::shared_ptr<V8WebSocketHub> InHub)
+    : Isolate(InIsolate), GContext(InIsolate, InContext), GSelf(InIsolate, InSelf), Hub(std::move(InHub))
 {
     GSelf.SetWeak<V8WebSocketClientImpl>(this, &OnGarbageCollectedWithFree, v8::WeakCallbackType::kInternalFields);
     // UE_LOG(LogTemp, Warning, TEXT(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> set weak %p"), this);
@@ -181,6 +274,24 @@ void V8WebSocketClientImpl::Connect(const v8::FunctionCallbackInfo<v8::Value>& I
 {
     std::string uri = *(v8::String::Utf8Value(Isolate, Info[0]));
 
+    if (Hub)
+    {
+        SharedConnection = std::make_shared<V8WebSocketSharedConnection>();
+        SharedConnection->Owner = this;
+        websocketpp::lib::error_code ec;
+        Hub->Connect(SharedConnection, uri, ec);
+        if (ec)
+        {
+            SharedConnection->Owner = nullptr;
+            std::stringstream ss;
+            ss << "could not create connection because: " << ec.message() << std::endl;
+            FV8Utils::ThrowException(Isolate, ss.str().c_str());
+            return;
+        }
+        Connenting = true;
+        return;
+    }
+
     Client.set_access_channels(websocketpp::log::alevel::none);
     Client.set_error_channels(websocketpp::log::elevel::none);
 
@@ -212,7 +323,7 @@ void V8WebSocketClientImpl::Connect(const v8::FunctionCallbackInfo<v8::Value>& I
 
 void V8WebSocketClientImpl::Send(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
-    if (Handle.expired())
+    if (Hub ? !SharedOpened : Handle.expired())
     {
         FV8Utils::ThrowException(Isolate, "WebSocket is not open");
         return;
@@ -225,6 +336,11 @@ void V8WebSocketClientImpl::Send(const v8::FunctionCallbackInfo<v8::Value>& Info
     if (Value->IsString())
     {
         v8::String::Utf8Value str(Isolate, Value);
+        if (Hub)
+        {
+            Hub->Send(SharedConnection, Hub->PrepareFrame(websocketpp::frame::opcode::TEXT, *str, str.length()));
+            return;
+        }
         std::string payload(*str, str.length());
         Client.send(Handle, payload, websocketpp::frame::opcode::TEXT, ec);
     }
@@ -248,6 +364,12 @@ void V8WebSocketClientImpl::Send(const v8::FunctionCallbackInfo<v8::Value>& Info
         return;
     }
 
+    if (bin && Hub)
+    {
+        Hub->Send(SharedConnection, Hub->PrepareFrame(websocketpp::frame::opcode::BINARY, bin, bin_len));
+        return;
+    }
+
     if (bin)
     {
         Client.send(Handle, bin, bin_len, websocketpp::frame::opcode::BINARY, ec);
@@ -280,6 +402,11 @@ void V8WebSocketClientImpl::Cleanup()
     }
     Connenting = false;
     Handle.reset();
+    SharedOpened = false;
+    if (SharedConnection)
+    {
+        SharedConnection->Owner = nullptr;
+    }
 
     v8::Isolate::Scope IsolateScope(Isolate);
     for (int i = 0; i < HANDLE_TYPE_END; ++i)
@@ -312,7 +439,14 @@ void V8WebSocketClientImpl::Close(const v8::FunctionCallbackInfo<v8::Value>& Inf
 
 void V8WebSocketClientImpl::Close(websocketpp::close::status::value const code, std::string const& reason)
 {
-    if (!Handle.expired())
+    if (Hub)
+    {
+        if (SharedConnection && SharedConnection->Owner)
+        {
+            Hub->Close(SharedConnection, code, reason);
+        }
+    }
+    else if (!Handle.expired())
     {
         Client.close(Handle, code, reason);
     }
@@ -321,6 +455,11 @@ void V8WebSocketClientImpl::Close(websocketpp::close::status::value const code,
 
 void V8WebSocketClientImpl::PollOne()
 {
+    // 共享模式由网络线程驱动
+    if (Hub)
+    {
+        return;
+    }
     if (Connenting || !Handle.expired())
     {
         Client.poll_one();
@@ -405,6 +544,307 @@ void V8WebSocketClientImpl::OnFail(wspp_connection_hdl InHandle)
     Close(websocketpp::close::status::abnormal_close, "");
 }
 
+void V8WebSocketClientImpl::OnSharedEvent(
+    HandlerType Type, const wspp_message_ptr& Message, int CloseCode, const std::string& Reason)
+{
+    if (!Isolate)
+    {
+        return;
+    }
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    // dispatch由js调用，一个回调抛异常不能影响同一批的其它事件
+    v8::TryCatch TryCatch(Isolate);
+    auto Context = GContext.Get(Isolate);
+
+    switch (Type)
+    {
+        case ON_OPEN:
+            Connenting = false;
+            SharedOpened = true;
+            if (!Handles[ON_OPEN].IsEmpty())
+            {
+                Handles[ON_OPEN].Get(Isolate)->Call(Context, v8::Undefined(Isolate), 0, nullptr);
+            }
+            break;
+        case ON_MESSAGE:
+            if (!Handles[ON_MESSAGE].IsEmpty())
+            {
+                v8::Local<v8::Value> args[1];
+                const std::string& Payload = Message->get_payload();
+                if (Message->get_opcode() == websocketpp::frame::opcode::TEXT)
+                {
+                    args[0] = v8::String::NewFromUtf8(Isolate, Payload.c_str(), v8::NewStringType::kNormal, Payload.size())
+                                  .ToLocalChecked();
+                }
+                else if (Message->get_opcode() == websocketpp::frame::opcode::BINARY)
+                {
+                    // 消息在本次派发后释放，需要拷贝到js自己的ArrayBuffer
+                    auto Ab = v8::ArrayBuffer::New(Isolate, Payload.size());
+                    if (!Payload.empty())
+                    {
+                        memcpy(DataTransfer::GetArrayBufferData(Ab), Payload.data(), Payload.size());
+                    }
+                    args[0] = Ab;
+                }
+                else
+                {
+                    args[0] = v8::Undefined(Isolate);
+                }
+                Handles[ON_MESSAGE].Get(Isolate)->Call(Context, v8::Undefined(Isolate), 1, args);
+            }
+            break;
+        case ON_CLOSE:
+            if (!Handles[ON_CLOSE].IsEmpty())
+            {
+                v8::Local<v8::Value> args[2] = {v8::Integer::New(Isolate, CloseCode),
+                    v8::String::NewFromUtf8(Isolate, Reason.c_str(), v8::NewStringType::kNormal, Reason.size()).ToLocalChecked()};
+                Handles[ON_CLOSE].Get(Isolate)->Call(Context, v8::Undefined(Isolate), 2, args);
+            }
+            Cleanup();
+            break;
+        case ON_FAIL:
+            if (!Handles[ON_FAIL].IsEmpty())
+            {
+                v8::Local<v8::Value> args[1] = {
+                    v8::String::NewFromUtf8(Isolate, Reason.c_str(), v8::NewStringType::kNormal, Reason.size()).ToLocalChecked()};
+                Handles[ON_FAIL].Get(Isolate)->Call(Context, v8::Undefined(Isolate), 1, args);
+            }
+            Close(websocketpp::close::status::abnormal_close, "");
+            break;
+        default:
+            break;
+    }
+}
+
+std::mutex V8WebSocketHub::HubsMutex;
+
+std::map<v8::Isolate*, std::shared_ptr<V8WebSocketHub>> V8WebSocketHub::Hubs;
+
+std::shared_ptr<V8WebSocketHub> V8WebSocketHub::Get(v8::Isolate* Isolate)
+{
+    std::lock_guard<std::mutex> Guard(HubsMutex);
+    auto Iter = Hubs.find(Isolate);
+    if (Iter != Hubs.end())
+    {
+        return Iter->second;
+    }
+    auto Hub = std::make_shared<V8WebSocketHub>();
+    Hubs[Isolate] = Hub;
+    return Hub;
+}
+
+int V8WebSocketHub::Dispatch(v8::Isolate* Isolate)
+{
+    std::shared_ptr<V8WebSocketHub> Hub;
+    {
+        std::lock_guard<std::mutex> Guard(HubsMutex);
+        auto Iter = Hubs.find(Isolate);
+        if (Iter == Hubs.end())
+        {
+            return 0;
+        }
+        Hub = Iter->second;
+    }
+
+    int Count = 0;
+    FEvent* Event = Hub->PopAll();
+    while (Event)
+    {
+        std::unique_ptr<FEvent> Current(Event);
+        Event = Event->Next;
+        // 回调里可能close或者触发gc释放其它socket，每次都重新取Owner
+        if (auto Owner = Current->Connection->Owner)
+        {
+            Owner->OnSharedEvent(Current->Type, Current->Message, Current->CloseCode, Current->Reason);
+            ++Count;
+        }
+    }
+    return Count;
+}
+
+void V8WebSocketHub::Release(v8::Isolate* Isolate)
+{
+    std::shared_ptr<V8WebSocketHub> Hub;
+    {
+        std::lock_guard<std::mutex> Guard(HubsMutex);
+        auto Iter = Hubs.find(Isolate);
+        if (Iter == Hubs.end())
+        {
+            return;
+        }
+        Hub = Iter->second;
+        Hubs.erase(Iter);
+    }
+    // 未被gc的socket还持有Hub，这里要主动停掉网络线程
+    Hub->Shutdown();
+}
+
+V8WebSocketHub::V8WebSocketHub()
+{
+    Client.set_access_channels(websocketpp::log::alevel::none);
+    Client.set_error_channels(websocketpp::log::elevel::none);
+#if defined(WITH_WEBSOCKET_SSL)
+    Client.set_tls_init_handler(&on_tls_init);
+#endif
+    Client.init_asio();
+    Client.start_perpetual();
+    Thread = std::thread([this]() { Client.run(); });
+}
+
+V8WebSocketHub::~V8WebSocketHub()
+{
+    Shutdown();
+    FEvent* Event = PopAll();
+    while (Event)
+    {
+        FEvent* Next = Event->Next;
+        delete Event;
+        Event = Next;
+    }
+}
+
+void V8WebSocketHub::Shutdown()
+{
+    if (Thread.joinable())
+    {
+        Client.stop_perpetual();
+        Client.stop();
+        Thread.join();
+    }
+}
+
+void V8WebSocketHub::Push(FEvent* Event)
+{
+    Event->Next = Head.load(std::memory_order_relaxed);
+    while (!Head.compare_exchange_weak(Event->Next, Event, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+}
+
+V8WebSocketHub::FEvent* V8WebSocketHub::PopAll()
+{
+    FEvent* Event = Head.exchange(nullptr, std::memory_order_acquire);
+    // 反转成到达顺序
+    FEvent* Ordered = nullptr;
+    while (Event)
+    {
+        FEvent* Next = Event->Next;
+        Event->Next = Ordered;
+        Ordered = Event;
+        Event = Next;
+    }
+    return Ordered;
+}
+
+void V8WebSocketHub::Connect(
+    std::shared_ptr<V8WebSocketSharedConnection> Connection, const std::string& Uri, websocketpp::lib::error_code& ec)
+{
+    wspp_client::connection_ptr con = Client.get_connection(Uri, ec);
+    if (ec)
+    {
+        return;
+    }
+
+    // 以下回调都在网络线程执行，只能访问Connection里网络线程的字段
+    con->set_open_handler(
+        [this, Connection](wspp_connection_hdl InHandle)
+        {
+            Connection->Handle = InHandle;
+            if (Connection->Closing)
+            {
+                websocketpp::lib::error_code ec;
+                Client.close(InHandle, websocketpp::close::status::going_away, "", ec);
+                return;
+            }
+            Push(new FEvent{Connection, V8WebSocketClientImpl::ON_OPEN});
+        });
+    con->set_message_handler(
+        [this, Connection](wspp_connection_hdl InHandle, wspp_message_ptr InMessage)
+        {
+            FEvent* Event = new FEvent{Connection, V8WebSocketClientImpl::ON_MESSAGE};
+            Event->Message = std::move(InMessage);
+            Push(Event);
+        });
+    con->set_close_handler(
+        [this, Connection](wspp_connection_hdl InHandle)
+        {
+            websocketpp::lib::error_code ec;
+            wspp_client::connection_ptr con = Client.get_con_from_hdl(InHandle, ec);
+            FEvent* Event = new FEvent{Connection, V8WebSocketClientImpl::ON_CLOSE};
+            if (con)
+            {
+                Event->CloseCode = con->get_remote_close_code();
+                Event->Reason = con->get_remote_close_reason();
+            }
+            Push(Event);
+        });
+    con->set_fail_handler(
+        [this, Connection](wspp_connection_hdl InHandle)
+        {
+            websocketpp::lib::error_code ec;
+            wspp_client::connection_ptr con = Client.get_con_from_hdl(InHandle, ec);
+            FEvent* Event = new FEvent{Connection, V8WebSocketClientImpl::ON_FAIL};
+            if (con)
+            {
+                Event->Reason = con->get_ec().message();
+            }
+            Push(Event);
+        });
+
+    puerts_asio::post(Client.get_io_service(), [this, con]() { Client.connect(con); });
+}
+
+void V8WebSocketHub::Send(std::shared_ptr<V8WebSocketSharedConnection> Connection, wspp_message_ptr Message)
+{
+    puerts_asio::post(Client.get_io_service(),
+        [this, Connection, Message]()
+        {
+            // 连接已经在关闭时send会失败，close事件随后会通知js，这里忽略
+            websocketpp::lib::error_code ec;
+            Client.send(Connection->Handle, Message, ec);
+        });
+}
+
+void V8WebSocketHub::Close(
+    std::shared_ptr<V8WebSocketSharedConnection> Connection, websocketpp::close::status::value Code, const std::string& Reason)
+{
+    if (Connection->Closing.exchange(true))
+    {
+        return;
+    }
+    puerts_asio::post(Client.get_io_service(),
+        [this, Connection, Code, Reason]()
+        {
+            // 还没连上时Handle为空，由open回调负责关闭
+            websocketpp::lib::error_code ec;
+            Client.close(Connection->Handle, Code, Reason, ec);
+        });
+}
+
+wspp_message_ptr V8WebSocketHub::PrepareFrame(websocketpp::frame::opcode::value Op, const void* Data, size_t Length)
+{
+    using wspp_message = wspp_message_ptr::element_type;
+    wspp_message_ptr Message = websocketpp::lib::make_shared<wspp_message>(wspp_message::con_msg_man_ptr(), Op, 0);
+
+    // 客户端发出的帧必须加掩码，加掩码的同时完成从js内存到消息的唯一一次拷贝
+    websocketpp::frame::masking_key_type Key;
+    Key.i = MaskingKeyGenerator();
+    std::string& Payload = Message->get_raw_payload();
+    Payload.resize(Length);
+    if (Length > 0)
+    {
+        websocketpp::frame::word_mask_exact(
+            static_cast<uint8_t*>(const_cast<void*>(Data)), reinterpret_cast<uint8_t*>(&Payload[0]), Length, Key);
+    }
+
+    websocketpp::frame::basic_header Header(Op, Length, true, true);
+    websocketpp::frame::extended_header ExtendedHeader(Length, Key.i);
+    Message->set_header(websocketpp::frame::prepare_header(Header, ExtendedHeader));
+    Message->set_prepared(true);
+    return Message;
+}
+
 }    // namespace PUERTS_NAMESPACE
 
 void InitWebsocketPPWrap(v8::Local<v8::Context> Context)
@@ -413,8 +853,14 @@ void InitWebsocketPPWrap(v8::Local<v8::Context> Context)
     auto WSTemplate = v8::FunctionTemplate::New(Context->GetIsolate(),
         [](const v8::FunctionCallbackInfo<v8::Value>& Info)
         {
-            auto ws =
-                new PUERTS_NAMESPACE::V8WebSocketClientImpl(Info.GetIsolate(), Info.GetIsolate()->GetCurrentContext(), Info.This());
+            // 第二个参数为true时使用共享网络线程
+            std::shared_ptr<PUERTS_NAMESPACE::V8WebSocketHub> Hub;
+            if (Info.Length() > 1 && Info[1]->IsTrue())
+            {
+                Hub = PUERTS_NAMESPACE::V8WebSocketHub::Get(Info.GetIsolate());
+            }
+            auto ws = new PUERTS_NAMESPACE::V8WebSocketClientImpl(
+                Info.GetIsolate(), Info.GetIsolate()->GetCurrentContext(), Info.This(), std::move(Hub));
             Info.This()->SetAlignedPointerInInternalField(0, ws);
             ws->Connect(Info);
         });
@@ -451,8 +897,19 @@ void InitWebsocketPPWrap(v8::Local<v8::Context> Context)
                     ->PollOne();
             }));
 
+    // 派发共享模式下网络线程收到的所有事件，返回派发的事件数
+    WSTemplate->Set(v8::String::NewFromUtf8(Isolate, "dispatch").ToLocalChecked(),
+        v8::FunctionTemplate::New(Isolate,
+            [](const v8::FunctionCallbackInfo<v8::Value>& Info)
+            { Info.GetReturnValue().Set(PUERTS_NAMESPACE::V8WebSocketHub::Dispatch(Info.GetIsolate())); }));
+
     Context->Global()->Set(Context, v8::String::NewFromUtf8(Isolate, "WebSocketPP").ToLocalChecked(),
         WSTemplate->GetFunction(Context).ToLocalChecked());
 }
 
+void UnInitWebsocketPPWrap(v8::Isolate* Isolate)
+{
+    PUERTS_NAMESPACE::V8WebSocketHub::Release(Isolate);
+}
+
 #endif
\ No newline at end of file
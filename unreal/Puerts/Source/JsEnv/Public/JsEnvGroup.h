@@ -38,6 +38,16 @@ public:
 
     void SetJsEnvSelector(std::function<int(UObject*, int)> InSelector);
 
+    // NotifyUObjectCreated的前置过滤，在询问任何虚拟机之前调用，可在加载线程调用
+    // 只有TypeScript生成类的CDO/Archetype以及UTypeScriptGeneratedClass对象本身需要TryBindJs，其它对象直接排除
+    static bool NeedTryBindJs(const class UObjectBase* InObject);
+
+    // 对象实际交给虚拟机TryBindJs时计数(FJsEnv::TryBindJs和FJsEnvGroup::TryBindJs)，每个对象只计一次
+    static void CountTryBindJsDispatched();
+
+    // 进程内累计：创建通知数、实际交给虚拟机处理数、被过滤数，脚本里通过getTryBindJsStatistics读取
+    static void GetTryBindJsStatistics(uint64& OutCreated, uint64& OutBound, uint64& OutRejected);
+
 private:
     std::vector<std::shared_ptr<IJsEnv>> JsEnvList;
 
@@ -0,0 +1,119 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+// 2/4/8路重载和无重载调用的耗时对比，只有头文件，不参与默认编译
+// 用法：在某个.cpp里包含本文件并写一次PUERTS_OVERLOAD_DISPATCH_BENCHMARK_REGISTER()，然后在js虚拟机里执行OverloadDispatchBenchmarkScript()
+// Set2/Set4/Set8分别由前2/4/8个重载组成，脚本调用的都是最后一个重载，即顺序尝试时代价最大的情况
+
+#include <string>
+#include "Binding.hpp"
+
+namespace PUERTS_NAMESPACE
+{
+struct FOverloadDispatchBenchmark
+{
+    static int32_t Plain(int32_t A, int32_t B)
+    {
+        return A + B;
+    }
+
+    static int32_t Set(int32_t A)
+    {
+        return A;
+    }
+
+    static int32_t Set(const std::string& A)
+    {
+        return static_cast<int32_t>(A.size());
+    }
+
+    static int32_t Set(int32_t A, int32_t B)
+    {
+        return A + B;
+    }
+
+    static int32_t Set(int32_t A, const std::string& B)
+    {
+        return A + static_cast<int32_t>(B.size());
+    }
+
+    static int32_t Set(const std::string& A, int32_t B)
+    {
+        return static_cast<int32_t>(A.size()) + B;
+    }
+
+    static int32_t Set(bool A, int32_t B)
+    {
+        return A ? B : 0;
+    }
+
+    static int32_t Set(int32_t A, int32_t B, int32_t C)
+    {
+        return A + B + C;
+    }
+
+    static int32_t Set(int32_t A, bool B)
+    {
+        return B ? A : 0;
+    }
+};
+
+inline const char* OverloadDispatchBenchmarkScript()
+{
+    return R"((function() {
+    const B = puerts.loadCPPType('FOverloadDispatchBenchmark');
+    const N = 1000000;
+    const cases = [
+        ['Plain', (f) => f(1, 2)],
+        ['Set2', (f) => f('hello')],
+        ['Set4', (f) => f(1, 'hello')],
+        ['Set8', (f) => f(1, true)],
+    ];
+    for (const [name, body] of cases) {
+        const f = B[name];
+        const loop = new Function('f', 'body', 'n', 'let r; for (let i = 0; i < n; i++) r = body(f); return r;');
+        loop(f, body, N / 10);
+        const begin = Date.now();
+        loop(f, body, N);
+        console.log(`${name}: ${Date.now() - begin}ms`);
+    }
+})();
+)";
+}
+
+// 模板化是为了推迟到PUERTS_OVERLOAD_DISPATCH_BENCHMARK_REGISTER里UsingNamedCppType之后再实例化
+template <typename Self = FOverloadDispatchBenchmark>
+void RegisterOverloadDispatchBenchmark()
+{
+    DefineClass<Self>()
+        .Function("Plain", MakeFunction(&Self::Plain))
+        .Function("Set2", CombineOverloads(MakeOverload(int32_t(*)(int32_t), &Self::Set),
+                              MakeOverload(int32_t(*)(const std::string&), &Self::Set)))
+        .Function("Set4", CombineOverloads(MakeOverload(int32_t(*)(int32_t), &Self::Set),
+                              MakeOverload(int32_t(*)(const std::string&), &Self::Set), MakeOverload(int32_t(*)(int32_t, int32_t), &Self::Set),
+                              MakeOverload(int32_t(*)(int32_t, const std::string&), &Self::Set)))
+        .Function("Set8", CombineOverloads(MakeOverload(int32_t(*)(int32_t), &Self::Set),
+                              MakeOverload(int32_t(*)(const std::string&), &Self::Set), MakeOverload(int32_t(*)(int32_t, int32_t), &Self::Set),
+                              MakeOverload(int32_t(*)(int32_t, const std::string&), &Self::Set),
+                              MakeOverload(int32_t(*)(const std::string&, int32_t), &Self::Set), MakeOverload(int32_t(*)(bool, int32_t), &Self::Set),
+                              MakeOverload(int32_t(*)(int32_t, int32_t, int32_t), &Self::Set), MakeOverload(int32_t(*)(int32_t, bool), &Self::Set)))
+        .Register();
+}
+}    // namespace PUERTS_NAMESPACE
+
+#define PUERTS_OVERLOAD_DISPATCH_BENCHMARK_REGISTER()                                            \
+    UsingNamedCppType(PUERTS_NAMESPACE::FOverloadDispatchBenchmark, FOverloadDispatchBenchmark); \
+    static struct FOverloadDispatchBenchmarkAutoRegister                                         \
+    {                                                                                            \
+        FOverloadDispatchBenchmarkAutoRegister()                                                 \
+        {                                                                                        \
+            PUERTS_NAMESPACE::RegisterOverloadDispatchBenchmark();                               \
+        }                                                                                        \
+    } _OverloadDispatchBenchmarkAutoRegister__
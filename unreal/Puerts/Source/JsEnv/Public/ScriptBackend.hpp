@@ -99,6 +99,13 @@
     template <>                                                                                                         \
     struct Name##PuertsOverloads<SIGNATURE>                                                                             \
     {                                                                                                                   \
+        using ArgumentTypes = ::PUERTS_NAMESPACE::internal::traits::FunctionTrait<SIGNATURE>::Arguments;                \
+        static constexpr std::size_t DefaultCount = decltype(::PUERTS_NAMESPACE::CountType(__VA_ARGS__))::value;        \
+        static void uncheckedCall(::PUERTS_NAMESPACE::PUERTS_BINDING_IMPL::API::CallbackInfoType info)                  \
+        {                                                                                                               \
+            ::PUERTS_NAMESPACE::FuncCallWrapper<PUERTS_NAMESPACE::PUERTS_BINDING_IMPL::API, SIGNATURE, M,               \
+                true>::callWithDefaultValues(info, ##__VA_ARGS__);                                                      \
+        }                                                                                                               \
         static bool overloadCall(::PUERTS_NAMESPACE::PUERTS_BINDING_IMPL::API::CallbackInfoType info)                   \
         {                                                                                                               \
             return ::PUERTS_NAMESPACE::FuncCallWrapper<PUERTS_NAMESPACE::PUERTS_BINDING_IMPL::API, SIGNATURE, M,        \
@@ -32,6 +32,10 @@ unsigned int Count(Args&&... args)
     return sizeof...(Args);
 }
 
+// 只用于decltype，在编译期得到默认参数个数
+template <class... Args>
+std::integral_constant<std::size_t, sizeof...(Args)> CountType(Args&&... args);
+
 template <typename T>
 struct ArgumentBufferType<T*, typename std::enable_if<is_script_type<T>::value && !std::is_const<T>::value>::type>
 {
@@ -920,6 +924,9 @@ template <typename API, typename Ret, typename... Args, Ret (*func)(Args...), bo
     bool GetSelfFromData>
 struct FuncCallWrapper<API, Ret (*)(Args...), func, ReturnByPointer, ScriptTypePtrAsRef, GetSelfFromData>
 {
+    using ArgumentTypes = std::tuple<Args...>;
+    static constexpr std::size_t DefaultCount = 0;
+
     static void call(typename API::CallbackInfoType info)
     {
         using Helper = internal::FuncCallHelper<API, std::pair<Ret, std::tuple<Args...>>, false, ReturnByPointer,
@@ -927,6 +934,12 @@ struct FuncCallWrapper<API, Ret (*)(Args...), func, ReturnByPointer, ScriptTypeP
         Helper::call(func, info);
     }
 
+    // 参数已由OverloadDispatcher检查过
+    static void uncheckedCall(typename API::CallbackInfoType info)
+    {
+        call(info);
+    }
+
     static bool overloadCall(typename API::CallbackInfoType info)
     {
         using Helper = internal::FuncCallHelper<API, std::pair<Ret, std::tuple<Args...>>, true, ReturnByPointer, ScriptTypePtrAsRef,
@@ -987,6 +1000,9 @@ template <typename API, typename Inc, typename Ret, typename... Args, Ret (Inc::
     bool ScriptTypePtrAsRef, bool GetSelfFromData>
 struct FuncCallWrapper<API, Ret (Inc::*)(Args...), func, ReturnByPointer, ScriptTypePtrAsRef, GetSelfFromData>
 {
+    using ArgumentTypes = std::tuple<Args...>;
+    static constexpr std::size_t DefaultCount = 0;
+
     static void call(typename API::CallbackInfoType info)
     {
         using Helper = internal::FuncCallHelper<API, std::pair<Ret, std::tuple<Args...>>, false, ReturnByPointer,
@@ -994,6 +1010,12 @@ struct FuncCallWrapper<API, Ret (Inc::*)(Args...), func, ReturnByPointer, Script
         Helper::template callMethod<Inc>(func, info);
     }
 
+    // 参数已由OverloadDispatcher检查过
+    static void uncheckedCall(typename API::CallbackInfoType info)
+    {
+        call(info);
+    }
+
     static bool overloadCall(typename API::CallbackInfoType info)
     {
         using Helper = internal::FuncCallHelper<API, std::pair<Ret, std::tuple<Args...>>, true, ReturnByPointer, ScriptTypePtrAsRef,
@@ -1034,6 +1056,9 @@ template <typename API, typename Inc, typename Ret, typename... Args, Ret (Inc::
     bool ScriptTypePtrAsRef, bool GetSelfFromData>
 struct FuncCallWrapper<API, Ret (Inc::*)(Args...) const, func, ReturnByPointer, ScriptTypePtrAsRef, GetSelfFromData>
 {
+    using ArgumentTypes = std::tuple<Args...>;
+    static constexpr std::size_t DefaultCount = 0;
+
     static void call(typename API::CallbackInfoType info)
     {
         using Helper = internal::FuncCallHelper<API, std::pair<Ret, std::tuple<Args...>>, false, ReturnByPointer,
@@ -1041,6 +1066,12 @@ struct FuncCallWrapper<API, Ret (Inc::*)(Args...) const, func, ReturnByPointer,
         Helper::template callMethod<Inc>(func, info);
     }
 
+    // 参数已由OverloadDispatcher检查过
+    static void uncheckedCall(typename API::CallbackInfoType info)
+    {
+        call(info);
+    }
+
     static bool overloadCall(typename API::CallbackInfoType info)
     {
         using Helper = internal::FuncCallHelper<API, std::pair<Ret, std::tuple<Args...>>, true, ReturnByPointer, ScriptTypePtrAsRef,
@@ -1103,7 +1134,7 @@ private:
     };
 
     template <size_t... index>
-    static void* call(typename API::CallbackInfoType info, std::index_sequence<index...>)
+    static void* call(typename API::CallbackInfoType info, std::index_sequence<index...> seq)
     {
         auto context = API::GetContext(info);
 
@@ -1117,6 +1148,13 @@ private:
             return nullptr;
         }
 
+        return construct(info, context, seq);
+    }
+
+    template <size_t... index>
+    static void* construct(typename API::CallbackInfoType info, typename API::ContextType context, std::index_sequence<index...>)
+    {
+        (void) context;    // 无参构造时没有用到
 #if defined(WITH_THROW_IN_CPP) && defined(THREAD_LOCAL_IMPL_THROW)
         internal::ExceptionHandle<API>::TripleOp(info, nullptr, false);
 #endif
@@ -1133,10 +1171,18 @@ private:
     }
 
 public:
+    using ArgumentTypes = std::tuple<Args...>;
+    static constexpr std::size_t DefaultCount = 0;
+
     static void* call(typename API::CallbackInfoType info)
     {
         return call(info, std::make_index_sequence<ArgsLength>());
     }
+    // 参数已由OverloadDispatcher检查过
+    static void* uncheckedCall(typename API::CallbackInfoType info)
+    {
+        return construct(info, API::GetContext(info), std::make_index_sequence<ArgsLength>());
+    }
     static void* checkedCall(typename API::CallbackInfoType info)
     {
 #if defined(WITH_THROW_IN_CPP) && !defined(THREAD_LOCAL_IMPL_THROW)
@@ -1169,116 +1215,336 @@ public:
     }
 };
 
-template <typename API, typename... OverloadWraps>
-struct ConstructorsCombiner
+namespace internal
 {
-    template <typename API::InitializeFuncType Func, typename API::InitializeFuncType... Rest>
-    struct ConstructorRecursion
+// 重载分派：先按实参个数查表定位候选，候选之间类型相同的位置只检查一次，每个候选只需再检查它自己有区别的位置
+// 能参与分派的重载需要提供ArgumentTypes(std::tuple)、DefaultCount以及不做参数检查的uncheckedCall，
+// 其它(比如自定义的)重载保持原有语义，在所有参数个数下按声明顺序调用其overloadCall/call
+struct NoArgumentType
+{
+};
+
+template <typename W, typename = void>
+struct OverloadTrait
+{
+    static constexpr bool Dispatchable = false;
+    static constexpr std::size_t ArgsLength = 0;
+    static constexpr std::size_t MinArgs = 0;
+    static constexpr std::size_t DefaultCount = 0;
+
+    template <std::size_t Pos>
+    using CheckedType = NoArgumentType;
+};
+
+template <typename W>
+struct OverloadTrait<W, Void_t<typename W::ArgumentTypes, decltype(&W::uncheckedCall)>>
+{
+    static constexpr bool Dispatchable = true;
+    static constexpr std::size_t ArgsLength = std::tuple_size<typename W::ArgumentTypes>::value;
+    // 同FuncCallHelper::ArgumentsChecker，只检查非默认参数
+    static constexpr std::size_t MinArgs = ArgsLength - W::DefaultCount;
+    static constexpr std::size_t DefaultCount = W::DefaultCount;
+
+    template <std::size_t Pos, typename = void>
+    struct CheckedTypeImpl
     {
-        static void* _call(typename API::CallbackInfoType info)
-        {
-            auto Ret = Func(info);
-            if (Ret)
-                return Ret;
+        using type = NoArgumentType;
+    };
+
+    template <std::size_t Pos>
+    struct CheckedTypeImpl<Pos, typename std::enable_if<(Pos < MinArgs)>::type>
+    {
+        using type = typename ConverterDecay<typename std::tuple_element<Pos, typename W::ArgumentTypes>::type>::type;
+    };
+
+    template <std::size_t Pos>
+    using CheckedType = typename CheckedTypeImpl<Pos>::type;
+};
+
+template <typename API>
+struct FunctionOverloadPolicy
+{
+    using ResultType = bool;
+
+    template <typename W>
+    static bool Unchecked(typename API::CallbackInfoType info, bool& Out)
+    {
+        W::uncheckedCall(info);
+        Out = true;
+        return true;
+    }
+
+    template <typename W>
+    static bool Fallback(typename API::CallbackInfoType info, bool& Out)
+    {
+        Out = W::overloadCall(info);
+        return Out;
+    }
+};
+
+template <typename API>
+struct ConstructorOverloadPolicy
+{
+    using ResultType = void*;
 
+    template <typename W>
+    static bool Unchecked(typename API::CallbackInfoType info, void*& Out)
+    {
+        Out = W::uncheckedCall(info);
+        return true;
+    }
+
+    template <typename W>
+    static bool Fallback(typename API::CallbackInfoType info, void*& Out)
+    {
+        Out = W::call(info);
+        if (Out)
+            return true;
 #if defined(WITH_THROW_IN_CPP) && defined(THREAD_LOCAL_IMPL_THROW)
-            // get state, if not exception
-            if (internal::ExceptionHandle<API>::TripleOp(info, nullptr, true))
-            {
-                return Ret;
-            }
+        // 构造时抛了异常，不再尝试后面的重载
+        if (ExceptionHandle<API>::TripleOp(info, nullptr, true))
+            return true;
 #endif
-            // try next overload
-            return ConstructorRecursion<Rest...>::_call(info);
+        return false;
+    }
+};
+
+template <typename API, typename Policy, typename... Wraps>
+struct OverloadDispatcher
+{
+    using ResultType = typename Policy::ResultType;
+
+    template <std::size_t A, std::size_t B>
+    struct Max : std::integral_constant<std::size_t, (A > B ? A : B)>
+    {
+    };
+
+    template <typename... Ws>
+    struct MaxArgsOf : std::integral_constant<std::size_t, 0>
+    {
+    };
+
+    template <typename W, typename... Ws>
+    struct MaxArgsOf<W, Ws...> : Max<OverloadTrait<W>::ArgsLength, MaxArgsOf<Ws...>::value>
+    {
+    };
+
+    static constexpr std::size_t MaxArgs = MaxArgsOf<Wraps...>::value;
+
+    // 和FuncCallHelper::ArgumentsChecker一致：没有默认参数的要求个数相等，有默认参数的只限制下限
+    template <typename W, std::size_t N>
+    struct InBucket
+        : std::integral_constant<bool, OverloadTrait<W>::Dispatchable && OverloadTrait<W>::MinArgs <= N &&
+                                           (N <= OverloadTrait<W>::ArgsLength || OverloadTrait<W>::DefaultCount > 0)>
+    {
+    };
+
+    // 第N个桶里所有可分派的候选在Pos位置检查的类型都相同(至少两个候选)，Ref为其类型
+    template <std::size_t N, std::size_t Pos, typename Ref, std::size_t Count, typename... Ws>
+    struct CommonAt
+    {
+        static constexpr bool value = Count > 1;
+        using type = Ref;
+    };
+
+    template <std::size_t N, std::size_t Pos, typename Ref, std::size_t Count, typename W, typename... Ws>
+    struct CommonAt<N, Pos, Ref, Count, W, Ws...>
+    {
+        using Checked = typename OverloadTrait<W>::template CheckedType<Pos>;
+        using Next = CommonAt<N, Pos, typename std::conditional<InBucket<W, N>::value, Checked, Ref>::type,
+            Count + (InBucket<W, N>::value ? 1 : 0), Ws...>;
+        static constexpr bool Mismatch =
+            InBucket<W, N>::value && (std::is_same<Checked, NoArgumentType>::value || (Count > 0 && !std::is_same<Checked, Ref>::value));
+        static constexpr bool value = !Mismatch && Next::value;
+        using type = typename Next::type;
+    };
+
+    template <std::size_t N, std::size_t Pos>
+    using Common = CommonAt<N, Pos, NoArgumentType, 0, Wraps...>;
+
+    template <bool Enable, typename T>
+    struct AcceptIf
+    {
+        static bool Check(typename API::ContextType context, typename API::ValueType value)
+        {
+            return true;
         }
+    };
 
-        static void* call(typename API::CallbackInfoType info)
+    template <typename T>
+    struct AcceptIf<true, T>
+    {
+        static bool Check(typename API::ContextType context, typename API::ValueType value)
         {
-#if defined(WITH_THROW_IN_CPP) && !defined(THREAD_LOCAL_IMPL_THROW)
-            try
+            return API::template Converter<T>::accept(context, value);
+        }
+    };
+
+    template <std::size_t N, std::size_t Pos, typename = void>
+    struct CommonChecker
+    {
+        static bool Check(typename API::CallbackInfoType info, typename API::ContextType context)
+        {
+            return true;
+        }
+    };
+
+    template <std::size_t N, std::size_t Pos>
+    struct CommonChecker<N, Pos, typename std::enable_if<(Pos < N)>::type>
+    {
+        static bool Check(typename API::CallbackInfoType info, typename API::ContextType context)
+        {
+            if (!AcceptIf<Common<N, Pos>::value, typename Common<N, Pos>::type>::Check(context, API::GetArg(info, Pos)))
             {
-#endif
-                auto Ret = _call(info);
-                if (!Ret)
-                {
-#if defined(WITH_THROW_IN_CPP) && defined(THREAD_LOCAL_IMPL_THROW)
-                    // get state, if not exception
-                    if (!internal::ExceptionHandle<API>::TripleOp(info, nullptr, true))
-#endif
-                        API::ThrowException(info, "invalid parameter!");
-                }
-                return Ret;
-#if defined(WITH_THROW_IN_CPP) && !defined(THREAD_LOCAL_IMPL_THROW)
+                return false;
             }
-            catch (std::exception& e)
+            return CommonChecker<N, Pos + 1>::Check(info, context);
+        }
+    };
+
+    // 候选W自己需要检查的位置：非默认参数里不属于公共检查的那些
+    template <std::size_t N, typename W, std::size_t Pos, typename = void>
+    struct OwnChecker
+    {
+        static bool Check(typename API::CallbackInfoType info, typename API::ContextType context)
+        {
+            return true;
+        }
+    };
+
+    template <std::size_t N, typename W, std::size_t Pos>
+    struct OwnChecker<N, W, Pos, typename std::enable_if<(Pos < N && Pos < OverloadTrait<W>::MinArgs)>::type>
+    {
+        static bool Check(typename API::CallbackInfoType info, typename API::ContextType context)
+        {
+            if (!AcceptIf<!Common<N, Pos>::value, typename OverloadTrait<W>::template CheckedType<Pos>>::Check(
+                    context, API::GetArg(info, Pos)))
             {
-                API::ThrowException(info, e.what());
+                return false;
             }
-            return nullptr;
-#endif
+            return OwnChecker<N, W, Pos + 1>::Check(info, context);
+        }
+    };
+
+    template <std::size_t N, typename W>
+    static bool Try(typename API::CallbackInfoType info, typename API::ContextType context, bool CommonPassed, ResultType& Out,
+        std::true_type /* dispatchable */)
+    {
+        if (!InBucket<W, N>::value || !CommonPassed || !OwnChecker<N, W, 0>::Check(info, context))
+            return false;
+        return Policy::template Unchecked<W>(info, Out);
+    }
+
+    template <std::size_t N, typename W>
+    static bool Try(typename API::CallbackInfoType info, typename API::ContextType context, bool CommonPassed, ResultType& Out,
+        std::false_type /* dispatchable */)
+    {
+        return Policy::template Fallback<W>(info, Out);
+    }
+
+    template <std::size_t N, typename... Ws>
+    struct Candidates
+    {
+        static bool Call(typename API::CallbackInfoType info, typename API::ContextType context, bool CommonPassed, ResultType& Out)
+        {
+            return false;
         }
     };
 
-    template <typename API::InitializeFuncType Func>
-    struct ConstructorRecursion<Func>
+    template <std::size_t N, typename W, typename... Ws>
+    struct Candidates<N, W, Ws...>
     {
-        static void* _call(typename API::CallbackInfoType info)
+        static bool Call(typename API::CallbackInfoType info, typename API::ContextType context, bool CommonPassed, ResultType& Out)
         {
-            return Func(info);
+            if (Try<N, W>(info, context, CommonPassed, Out, std::integral_constant<bool, OverloadTrait<W>::Dispatchable>()))
+                return true;
+            return Candidates<N, Ws...>::Call(info, context, CommonPassed, Out);
         }
     };
 
-    static void* call(typename API::CallbackInfoType info)
+    template <std::size_t N>
+    static bool Bucket(typename API::CallbackInfoType info, ResultType& Out)
     {
-        return ConstructorRecursion<(&OverloadWraps::call)...>::call(info);
+        auto context = API::GetContext(info);
+        bool CommonPassed = CommonChecker<N, 0>::Check(info, context);
+        return Candidates<N, Wraps...>::Call(info, context, CommonPassed, Out);
     }
 
-    static constexpr int length = sizeof...(OverloadWraps);
+    template <size_t... index>
+    static bool Dispatch(typename API::CallbackInfoType info, ResultType& Out, std::index_sequence<index...>)
+    {
+        typedef bool (*BucketType)(typename API::CallbackInfoType info, ResultType& Out);
+        static const BucketType Buckets[] = {&Bucket<index>...};
+        auto ArgsLen = API::GetArgsLen(info);
+        if (ArgsLen >= 0 && static_cast<std::size_t>(ArgsLen) <= MaxArgs)
+        {
+            return Buckets[ArgsLen](info, Out);
+        }
+        // 超过所有重载的参数个数，只剩带默认参数的和不可分派的重载可以尝试
+        return Bucket<MaxArgs + 1>(info, Out);
+    }
 
-    static const CFunctionInfo** infos()
+    // 返回是否有重载处理了这次调用
+    static bool Call(typename API::CallbackInfoType info, ResultType& Out)
     {
-        static const CFunctionInfo* _infos[sizeof...(OverloadWraps)] = {OverloadWraps::info()...};
-        return _infos;
+        return Dispatch(info, Out, std::make_index_sequence<MaxArgs + 1>());
     }
 };
+}    // namespace internal
 
 template <typename API, typename... OverloadWraps>
-struct OverloadsCombiner
+struct ConstructorsCombiner
 {
-    typedef bool (*V8FunctionCallbackWithBoolRet)(typename API::CallbackInfoType info);
+    using Dispatcher = internal::OverloadDispatcher<API, internal::ConstructorOverloadPolicy<API>, OverloadWraps...>;
 
-    template <V8FunctionCallbackWithBoolRet Func, V8FunctionCallbackWithBoolRet... Rest>
-    struct OverloadsRecursion
+    static void* call(typename API::CallbackInfoType info)
     {
-        static bool _call(typename API::CallbackInfoType info)
-        {
-            if (Func(info))
-                return true;
-            else
-                return OverloadsRecursion<Rest...>::_call(info);
-        }
-
-        static void call(typename API::CallbackInfoType info)
+#if defined(WITH_THROW_IN_CPP) && !defined(THREAD_LOCAL_IMPL_THROW)
+        try
         {
-            if (!_call(info))
+#endif
+            void* Ret = nullptr;
+            Dispatcher::Call(info, Ret);
+            if (!Ret)
             {
-                API::ThrowException(info, "invalid parameter!");
+#if defined(WITH_THROW_IN_CPP) && defined(THREAD_LOCAL_IMPL_THROW)
+                // get state, if not exception
+                if (!internal::ExceptionHandle<API>::TripleOp(info, nullptr, true))
+#endif
+                    API::ThrowException(info, "invalid parameter!");
             }
+            return Ret;
+#if defined(WITH_THROW_IN_CPP) && !defined(THREAD_LOCAL_IMPL_THROW)
         }
-    };
-
-    template <V8FunctionCallbackWithBoolRet Func>
-    struct OverloadsRecursion<Func>
-    {
-        static bool _call(typename API::CallbackInfoType info)
+        catch (std::exception& e)
         {
-            return Func(info);
+            API::ThrowException(info, e.what());
         }
-    };
+        return nullptr;
+#endif
+    }
+
+    static constexpr int length = sizeof...(OverloadWraps);
+
+    static const CFunctionInfo** infos()
+    {
+        static const CFunctionInfo* _infos[sizeof...(OverloadWraps)] = {OverloadWraps::info()...};
+        return _infos;
+    }
+};
+
+template <typename API, typename... OverloadWraps>
+struct OverloadsCombiner
+{
+    using Dispatcher = internal::OverloadDispatcher<API, internal::FunctionOverloadPolicy<API>, OverloadWraps...>;
 
     static void call(typename API::CallbackInfoType info)
     {
-        OverloadsRecursion<(&OverloadWraps::overloadCall)...>::call(info);
+        bool Handled = false;
+        if (!Dispatcher::Call(info, Handled))
+        {
+            API::ThrowException(info, "invalid parameter!");
+        }
     }
 
     static constexpr int length = sizeof...(OverloadWraps);
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <string>
+#include "TypedArraySpan.hpp"
 #ifdef WITH_V8_FAST_CALL
 #include "V8FastCall.hpp"
 #endif
@@ -217,6 +218,29 @@ struct ScriptTypeName<void>
     }
 };
 
+#define __DefTypedArraySpanTypeName(T, NAME)        \
+    template <>                                     \
+    struct ScriptTypeName<TypedArraySpan<T>>        \
+    {                                               \
+        static constexpr auto value()               \
+        {                                           \
+            return internal::Literal(NAME);         \
+        }                                           \
+    }
+
+__DefTypedArraySpanTypeName(int8_t, "Int8Array");
+__DefTypedArraySpanTypeName(uint8_t, "Uint8Array");
+__DefTypedArraySpanTypeName(int16_t, "Int16Array");
+__DefTypedArraySpanTypeName(uint16_t, "Uint16Array");
+__DefTypedArraySpanTypeName(int32_t, "Int32Array");
+__DefTypedArraySpanTypeName(uint32_t, "Uint32Array");
+__DefTypedArraySpanTypeName(int64_t, "BigInt64Array");
+__DefTypedArraySpanTypeName(uint64_t, "BigUint64Array");
+__DefTypedArraySpanTypeName(float, "Float32Array");
+__DefTypedArraySpanTypeName(double, "Float64Array");
+
+#undef __DefTypedArraySpanTypeName
+
 template <typename T>
 struct StaticTypeId
 {
@@ -424,7 +448,8 @@ public:
 #ifdef WITH_V8_FAST_CALL
     virtual const class v8::CFunction* FastCallInfo() const override
     {
-        return V8FastCall<Ret (*)(Args...), func>::info();
+        // 扩展函数(StartParameter为1)的第一个参数来自receiver，V8FastCall没有处理这种情况，走慢路径
+        return StartParameter == 0 ? V8FastCall<Ret (*)(Args...), func>::info() : nullptr;
     };
 #endif
 
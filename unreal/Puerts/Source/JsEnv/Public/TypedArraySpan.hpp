@@ -0,0 +1,40 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "PuertsNamespaceDef.h"
+
+namespace PUERTS_NAMESPACE
+{
+// 指向js TypedArray内存的视图，不拥有数据，只在调用期间有效
+// 作为参数时只接受元素类型匹配的TypedArray(如float对应Float32Array)，修改会直接反映到js侧
+template <typename T>
+struct TypedArraySpan
+{
+    T* Data;
+    size_t Length;
+
+    T& operator[](size_t Index) const
+    {
+        return Data[Index];
+    }
+
+    T* begin() const
+    {
+        return Data;
+    }
+
+    T* end() const
+    {
+        return Data + Length;
+    }
+};
+}    // namespace PUERTS_NAMESPACE
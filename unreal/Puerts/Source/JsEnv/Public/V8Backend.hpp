@@ -447,6 +447,70 @@ struct Converter<std::string>
     }
 };
 
+template <typename T>
+struct TypedArraySpanTrait
+{
+};
+
+#define __DefTypedArraySpanTrait(T, ARRAY_TYPE)                                                         \
+    template <>                                                                                         \
+    struct TypedArraySpanTrait<T>                                                                       \
+    {                                                                                                   \
+        static bool Is(const v8::Local<v8::Value>& value)                                               \
+        {                                                                                               \
+            return value->Is##ARRAY_TYPE();                                                             \
+        }                                                                                               \
+        static v8::Local<v8::Value> New(v8::Local<v8::ArrayBuffer> buffer, size_t length)               \
+        {                                                                                               \
+            return v8::ARRAY_TYPE::New(buffer, 0, length);                                              \
+        }                                                                                               \
+    }
+
+__DefTypedArraySpanTrait(int8_t, Int8Array);
+__DefTypedArraySpanTrait(uint8_t, Uint8Array);
+__DefTypedArraySpanTrait(int16_t, Int16Array);
+__DefTypedArraySpanTrait(uint16_t, Uint16Array);
+__DefTypedArraySpanTrait(int32_t, Int32Array);
+__DefTypedArraySpanTrait(uint32_t, Uint32Array);
+__DefTypedArraySpanTrait(int64_t, BigInt64Array);
+__DefTypedArraySpanTrait(uint64_t, BigUint64Array);
+__DefTypedArraySpanTrait(float, Float32Array);
+__DefTypedArraySpanTrait(double, Float64Array);
+
+#undef __DefTypedArraySpanTrait
+
+template <typename T>
+struct Converter<TypedArraySpan<T>>
+{
+    // 返回值会拷贝到新建的ArrayBuffer里
+    static v8::Local<v8::Value> toScript(v8::Local<v8::Context> context, TypedArraySpan<T> value)
+    {
+        v8::Local<v8::ArrayBuffer> Ab = v8::ArrayBuffer::New(context->GetIsolate(), value.Length * sizeof(T));
+        if (value.Length > 0)
+        {
+            ::memcpy(DataTransfer::GetArrayBufferData(Ab), value.Data, value.Length * sizeof(T));
+        }
+        return TypedArraySpanTrait<T>::New(Ab, value.Length);
+    }
+
+    static TypedArraySpan<T> toCpp(v8::Local<v8::Context> context, const v8::Local<v8::Value>& value)
+    {
+        TypedArraySpan<T> Ret = {nullptr, 0};
+        if (TypedArraySpanTrait<T>::Is(value))
+        {
+            v8::Local<v8::TypedArray> View = value.As<v8::TypedArray>();
+            Ret.Data = reinterpret_cast<T*>(static_cast<char*>(DataTransfer::GetArrayBufferData(View->Buffer())) + View->ByteOffset());
+            Ret.Length = View->Length();
+        }
+        return Ret;
+    }
+
+    static bool accept(v8::Local<v8::Context> context, const v8::Local<v8::Value>& value)
+    {
+        return TypedArraySpanTrait<T>::Is(value);
+    }
+};
+
 template <>
 struct Converter<const char*>
 {
@@ -11,7 +11,41 @@
 #pragma warning(push, 0)
 #include <v8-fast-api-calls.h>
 #pragma warning(pop)
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
 #include "DataTransfer.h"
+#include "TypedArraySpan.hpp"
+
+// 下面几项能力依赖的v8版本，可以在外部预先定义为0/1覆盖
+
+// const char*/std::string参数走v8::FastOneByteString
+#ifndef PUERTS_FAST_CALL_ONE_BYTE_STRING
+#if V8_MAJOR_VERSION >= 10
+#define PUERTS_FAST_CALL_ONE_BYTE_STRING 1
+#else
+#define PUERTS_FAST_CALL_ONE_BYTE_STRING 0
+#endif
+#endif
+
+// TypedArraySpan参数走v8::FastApiTypedArray，v8 13移除了该接口
+#ifndef PUERTS_FAST_CALL_TYPED_ARRAY
+#if V8_MAJOR_VERSION >= 10 && V8_MAJOR_VERSION < 13
+#define PUERTS_FAST_CALL_TYPED_ARRAY 1
+#else
+#define PUERTS_FAST_CALL_TYPED_ARRAY 0
+#endif
+#endif
+
+// 64位整数参数/返回值，需要v8支持Int64Representation::kBigInt才能和慢路径一样用BigInt表示
+#ifndef PUERTS_FAST_CALL_INT64_AS_BIGINT
+#if V8_MAJOR_VERSION > 11 || (V8_MAJOR_VERSION == 11 && V8_MINOR_VERSION >= 8)
+#define PUERTS_FAST_CALL_INT64_AS_BIGINT 1
+#else
+#define PUERTS_FAST_CALL_INT64_AS_BIGINT 0
+#endif
+#endif
 
 namespace PUERTS_NAMESPACE
 {
@@ -56,7 +90,7 @@ struct FastCallArgument<T, typename std::enable_if<std::is_enum<T>::value>::type
 };
 
 template <typename T>
-struct FastCallArgument<T, typename std::enable_if<std::is_integral<T>::value || std::is_floating_point<T>::value>::type>
+struct FastCallArgument<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
 {
     using DeclType = typename std::decay<T>::type;
 
@@ -66,6 +100,32 @@ struct FastCallArgument<T, typename std::enable_if<std::is_integral<T>::value ||
     }
 };
 
+// v8 fast api只认int32_t/uint32_t，char/short之类统一按32位传，和慢路径的Int32Value/Uint32Value一致
+template <typename T>
+struct FastCallArgument<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) < 8>::type>
+{
+    using DeclType = typename std::conditional<std::is_signed<T>::value, int32_t, uint32_t>::type;
+
+    static T Get(DeclType i)
+    {
+        return static_cast<T>(i);
+    }
+};
+
+#if PUERTS_FAST_CALL_INT64_AS_BIGINT
+// 慢路径只接受BigInt，没有kBigInt的v8上不开放，免得快慢路径对number参数的处理不一致
+template <typename T>
+struct FastCallArgument<T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 8>::type>
+{
+    using DeclType = typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type;
+
+    static T Get(DeclType i)
+    {
+        return static_cast<T>(i);
+    }
+};
+#endif
+
 template <>
 struct FastCallArgument<bool>
 {
@@ -77,6 +137,125 @@ struct FastCallArgument<bool>
     }
 };
 
+#if PUERTS_FAST_CALL_ONE_BYTE_STRING
+// v8的one-byte字符串是latin1编码且不以0结尾，拷贝一份并把非ascii字符转成utf8，结果和慢路径的String::Utf8Value一致
+// 作为实参的临时对象，生命周期覆盖整个调用
+class FastCallStringHolder
+{
+public:
+    explicit FastCallStringHolder(const v8::FastOneByteString& Str)
+    {
+        const uint8_t* Begin = reinterpret_cast<const uint8_t*>(Str.data);
+        const uint8_t* End = Begin + Str.length;
+        const uint8_t* NonAscii = std::find_if(Begin, End, [](uint8_t c) { return c >= 0x80; });
+        if (NonAscii == End)
+        {
+            Value.assign(Str.data, Str.length);
+            return;
+        }
+        Value.reserve(Str.length * 2);
+        Value.assign(reinterpret_cast<const char*>(Begin), NonAscii - Begin);
+        for (const uint8_t* p = NonAscii; p != End; ++p)
+        {
+            if (*p < 0x80)
+            {
+                Value.push_back(static_cast<char>(*p));
+            }
+            else
+            {
+                Value.push_back(static_cast<char>(0xC0 | (*p >> 6)));
+                Value.push_back(static_cast<char>(0x80 | (*p & 0x3F)));
+            }
+        }
+    }
+
+    operator const char*() const
+    {
+        return Value.c_str();
+    }
+
+    operator const std::string&() const
+    {
+        return Value;
+    }
+
+private:
+    std::string Value;
+};
+
+template <typename T>
+struct FastCallArgument<T, typename std::enable_if<std::is_same<T, const char*>::value || std::is_same<T, std::string>::value ||
+                                                   std::is_same<T, const std::string&>::value>::type>
+{
+    using DeclType = const v8::FastOneByteString&;
+
+    static FastCallStringHolder Get(const v8::FastOneByteString& Str)
+    {
+        return FastCallStringHolder(Str);
+    }
+};
+#endif
+
+#if PUERTS_FAST_CALL_TYPED_ARRAY
+// FastApiTypedArray只保证数据4字节对齐，8字节元素可能拿不到对齐的指针，所以只开放不超过4字节的元素类型
+template <typename T>
+struct IsFastCallTypedArrayElement
+    : std::integral_constant<bool, std::is_same<T, uint8_t>::value || std::is_same<T, int32_t>::value ||
+                                       std::is_same<T, uint32_t>::value || std::is_same<T, float>::value>
+{
+};
+
+template <typename T>
+struct FastCallArgument<TypedArraySpan<T>, typename std::enable_if<IsFastCallTypedArrayElement<T>::value>::type>
+{
+    using DeclType = const v8::FastApiTypedArray<T>&;
+
+    static TypedArraySpan<T> Get(const v8::FastApiTypedArray<T>& Array)
+    {
+        TypedArraySpan<T> Ret = {nullptr, Array.length()};
+        Array.getStorageIfAligned(&Ret.Data);
+        return Ret;
+    }
+};
+
+template <typename T>
+struct FastCallArgument<const TypedArraySpan<T>&, typename std::enable_if<IsFastCallTypedArrayElement<T>::value>::type>
+    : FastCallArgument<TypedArraySpan<T>>
+{
+};
+#endif
+
+template <typename T, typename Enable = void>
+struct FastCallReturn
+{
+    using DeclType = T;
+};
+
+template <typename T>
+struct FastCallReturn<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+    using DeclType = int;
+};
+
+template <typename T>
+struct FastCallReturn<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>
+{
+    using DeclType = typename std::conditional<sizeof(T) == 8,
+        typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type,
+        typename std::conditional<std::is_signed<T>::value, int32_t, uint32_t>::type>::type;
+};
+
+template <typename F>
+V8_INLINE v8::CFunction MakeFastCallCFunction(F* Func)
+{
+#if PUERTS_FAST_CALL_INT64_AS_BIGINT
+    // 不含64位整数的签名不受影响
+    return v8::CFunction::Make(Func, v8::CFunctionInfo::Int64Representation::kBigInt);
+#else
+    return v8::CFunction::Make(Func);
+#endif
+}
+
 namespace internal
 {
 namespace fastcallutil
@@ -130,6 +309,7 @@ struct IsArgsSupportedHelper<std::tuple<Args...>,
 {
 };
 
+// 返回值只支持数值、bool和枚举，64位整数需要kBigInt
 template <typename T, typename = void>
 struct IsReturnSupportedHelper : std::false_type
 {
@@ -137,16 +317,12 @@ struct IsReturnSupportedHelper : std::false_type
 
 template <typename T>
 struct IsReturnSupportedHelper<T,
-    typename std::enable_if<IsArgSupportedHelper<T>::value && !std::is_pointer<T>::value && !std::is_integral<T>::value>::type>
+    typename std::enable_if<std::is_floating_point<T>::value || std::is_enum<T>::value ||
+                            (std::is_integral<T>::value && (sizeof(T) < 8 || PUERTS_FAST_CALL_INT64_AS_BIGINT))>::type>
     : std::true_type
 {
 };
 
-template <typename T>
-struct IsReturnSupportedHelper<T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) < 8>::type> : std::true_type
-{
-};
-
 template <>
 struct IsReturnSupportedHelper<void> : std::true_type
 {
@@ -166,14 +342,15 @@ struct V8FastCall<Ret (*)(Args...), func,
     typename std::enable_if<IsReturnSupportedHelper<Ret>::value && IsArgsSupportedHelper<std::tuple<Args...>>::value &&
                             (sizeof...(Args) > 0)>::type>
 {
-    static Ret Wrap(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
+    static typename FastCallReturn<Ret>::DeclType Wrap(
+        v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
     {
-        return func(FastCallArgument<Args>::Get(args)...);
+        return static_cast<typename FastCallReturn<Ret>::DeclType>(func(FastCallArgument<Args>::Get(args)...));
     }
 
     static const v8::CFunction* info()
     {
-        static v8::CFunction _info = v8::CFunction::Make(Wrap);
+        static v8::CFunction _info = MakeFastCallCFunction(Wrap);
         return &_info;
     }
 };
@@ -182,15 +359,16 @@ template <typename Inc, typename Ret, typename... Args, Ret (Inc::*func)(Args...
 struct V8FastCall<Ret (Inc::*)(Args...), func,
     typename std::enable_if<IsReturnSupportedHelper<Ret>::value && IsArgsSupportedHelper<std::tuple<Args...>>::value>::type>
 {
-    static Ret Wrap(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
+    static typename FastCallReturn<Ret>::DeclType Wrap(
+        v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
     {
         auto self = FastCallArgument<Inc*>::Get(receiver_obj);
-        return (self->*func)(FastCallArgument<Args>::Get(args)...);
+        return static_cast<typename FastCallReturn<Ret>::DeclType>((self->*func)(FastCallArgument<Args>::Get(args)...));
     }
 
     static const v8::CFunction* info()
     {
-        static v8::CFunction _info = v8::CFunction::Make(Wrap);
+        static v8::CFunction _info = MakeFastCallCFunction(Wrap);
         return &_info;
     }
 };
@@ -199,17 +377,48 @@ template <typename Inc, typename Ret, typename... Args, Ret (Inc::*func)(Args...
 struct V8FastCall<Ret (Inc::*)(Args...) const, func,
     typename std::enable_if<IsReturnSupportedHelper<Ret>::value && IsArgsSupportedHelper<std::tuple<Args...>>::value>::type>
 {
-    static Ret Wrap(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
+    static typename FastCallReturn<Ret>::DeclType Wrap(
+        v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
     {
         auto self = FastCallArgument<Inc*>::Get(receiver_obj);
-        return (self->*func)(FastCallArgument<Args>::Get(args)...);
+        return static_cast<typename FastCallReturn<Ret>::DeclType>((self->*func)(FastCallArgument<Args>::Get(args)...));
     }
 
     static const v8::CFunction* info()
     {
-        static v8::CFunction _info = v8::CFunction::Make(Wrap);
+        static v8::CFunction _info = MakeFastCallCFunction(Wrap);
         return &_info;
     }
 };
 
+// CombineOverloads的每个重载都会以同一个名字登记到ClassDefinition的MethodInfos/FunctionInfos里，这里把它们合成一组CFunction重载
+// v8只按实参个数挑选重载，所以要求每个重载都支持fast call、没有默认参数并且参数个数互不相同，否则返回false，整组走慢路径
+template <typename NamedFunctionInfoType>
+bool CollectFastCallOverloads(const NamedFunctionInfoType* Infos, const char* Name, std::vector<v8::CFunction>& OutOverloads)
+{
+    OutOverloads.clear();
+    if (!Infos || !Name)
+    {
+        return false;
+    }
+    std::vector<unsigned int> Arities;
+    for (const NamedFunctionInfoType* Info = Infos; Info->Name; ++Info)
+    {
+        if (strcmp(Info->Name, Name) != 0)
+        {
+            continue;
+        }
+        const v8::CFunction* FastCallInfo = Info->Type ? Info->Type->FastCallInfo() : nullptr;
+        unsigned int Arity = Info->Type ? Info->Type->ArgumentCount() : 0;
+        if (!FastCallInfo || Info->Type->DefaultCount() > 0 || std::find(Arities.begin(), Arities.end(), Arity) != Arities.end())
+        {
+            OutOverloads.clear();
+            return false;
+        }
+        Arities.push_back(Arity);
+        OutOverloads.push_back(*FastCallInfo);
+    }
+    return OutOverloads.size() > 1;
+}
+
 }    // namespace PUERTS_NAMESPACE
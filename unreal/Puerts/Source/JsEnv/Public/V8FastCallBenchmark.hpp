@@ -0,0 +1,155 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+// fast call和普通调用的耗时对比，只有头文件，不参与默认编译
+// 用法：在某个.cpp里包含本文件并写一次PUERTS_FAST_CALL_BENCHMARK_REGISTER()，然后在js虚拟机里执行FastCallBenchmarkScript()
+// 每种签名注册两份：Xxx带反射信息(可以走fast call)，XxxSlow不带反射信息(只走FunctionCallback)，结果用console.log输出
+// 函数要被TurboFan优化后才会走fast call，所以脚本会先预热
+
+#ifdef WITH_V8_FAST_CALL
+
+#include <cstring>
+#include <string>
+#include "Binding.hpp"
+
+namespace PUERTS_NAMESPACE
+{
+struct FFastCallBenchmark
+{
+    static int32_t AddInt(int32_t A, int32_t B)
+    {
+        return A + B;
+    }
+
+    static double AddDouble(double A, double B)
+    {
+        return A + B;
+    }
+
+    static bool Not(bool A)
+    {
+        return !A;
+    }
+
+    static int64_t AddInt64(int64_t A, int64_t B)
+    {
+        return A + B;
+    }
+
+    static int32_t CStrLength(const char* Str)
+    {
+        return static_cast<int32_t>(strlen(Str));
+    }
+
+    static int32_t StringLength(const std::string& Str)
+    {
+        return static_cast<int32_t>(Str.size());
+    }
+
+    static float SumFloats(TypedArraySpan<float> Values)
+    {
+        float Sum = 0;
+        for (float Value : Values)
+        {
+            Sum += Value;
+        }
+        return Sum;
+    }
+
+    static int32_t Overload(int32_t A)
+    {
+        return A;
+    }
+
+    static int32_t Overload(int32_t A, int32_t B)
+    {
+        return A + B;
+    }
+};
+
+inline const char* FastCallBenchmarkScript()
+{
+    return R"((function() {
+    const B = puerts.loadCPPType('FFastCallBenchmark');
+    const N = 1000000;
+    const floats = new Float32Array(16).fill(1);
+    const cases = [
+        ['AddInt', (f) => f(1, 2)],
+        ['AddDouble', (f) => f(1.5, 2.5)],
+        ['Not', (f) => f(true)],
+        ['AddInt64', (f) => f(1n, 2n)],
+        ['CStrLength', (f) => f('hello puerts')],
+        ['StringLength', (f) => f('hello puerts')],
+        ['SumFloats', (f) => f(floats)],
+        ['Overload', (f) => f(1) + f(1, 2)],
+    ];
+    function run(name, body) {
+        const f = B[name];
+        const loop = new Function('f', 'body', 'n', 'let r; for (let i = 0; i < n; i++) r = body(f); return r;');
+        loop(f, body, N / 10);
+        const begin = Date.now();
+        loop(f, body, N);
+        return Date.now() - begin;
+    }
+    for (const [name, body] of cases) {
+        const fast = run(name, body);
+        const slow = run(name + 'Slow', body);
+        console.log(`${name}: fast ${fast}ms, slow ${slow}ms, x${(slow / Math.max(fast, 1)).toFixed(2)}`);
+    }
+})();
+)";
+}
+
+// FunctionCallback不带反射信息注册，ReflectionInfo为空，不会生成fast call
+#define __FastCallBenchmarkSlow(M) \
+    [](::PUERTS_NAMESPACE::PUERTS_BINDING_IMPL::API::CallbackInfoType info) \
+    { ::PUERTS_NAMESPACE::FuncCallWrapper<PUERTS_NAMESPACE::PUERTS_BINDING_IMPL::API, decltype(M), M, false>::call(info); }, nullptr
+
+// 模板化是为了推迟到PUERTS_FAST_CALL_BENCHMARK_REGISTER里UsingNamedCppType之后再实例化
+template <typename Self = FFastCallBenchmark>
+void RegisterFastCallBenchmark()
+{
+    using OverloadCombiner = OverloadsCombiner<PUERTS_BINDING_IMPL::API, MakeOverload(int32_t(*)(int32_t), &Self::Overload),
+        MakeOverload(int32_t(*)(int32_t, int32_t), &Self::Overload)>;
+    DefineClass<Self>()
+        .Function("AddInt", MakeFunction(&Self::AddInt))
+        .Function("AddIntSlow", __FastCallBenchmarkSlow(&Self::AddInt))
+        .Function("AddDouble", MakeFunction(&Self::AddDouble))
+        .Function("AddDoubleSlow", __FastCallBenchmarkSlow(&Self::AddDouble))
+        .Function("Not", MakeFunction(&Self::Not))
+        .Function("NotSlow", __FastCallBenchmarkSlow(&Self::Not))
+        .Function("AddInt64", MakeFunction(&Self::AddInt64))
+        .Function("AddInt64Slow", __FastCallBenchmarkSlow(&Self::AddInt64))
+        .Function("CStrLength", MakeFunction(&Self::CStrLength))
+        .Function("CStrLengthSlow", __FastCallBenchmarkSlow(&Self::CStrLength))
+        .Function("StringLength", MakeFunction(&Self::StringLength))
+        .Function("StringLengthSlow", __FastCallBenchmarkSlow(&Self::StringLength))
+        .Function("SumFloats", MakeFunction(&Self::SumFloats))
+        .Function("SumFloatsSlow", __FastCallBenchmarkSlow(&Self::SumFloats))
+        .Function("Overload", CombineOverloads(MakeOverload(int32_t(*)(int32_t), &Self::Overload),
+                                  MakeOverload(int32_t(*)(int32_t, int32_t), &Self::Overload)))
+        .Function("OverloadSlow", &OverloadCombiner::call, nullptr)
+        .Register();
+}
+
+#undef __FastCallBenchmarkSlow
+}    // namespace PUERTS_NAMESPACE
+
+#define PUERTS_FAST_CALL_BENCHMARK_REGISTER()                                        \
+    UsingNamedCppType(PUERTS_NAMESPACE::FFastCallBenchmark, FFastCallBenchmark);     \
+    static struct FFastCallBenchmarkAutoRegister                                     \
+    {                                                                                \
+        FFastCallBenchmarkAutoRegister()                                             \
+        {                                                                            \
+            PUERTS_NAMESPACE::RegisterFastCallBenchmark();                           \
+        }                                                                            \
+    } _FastCallBenchmarkAutoRegister__
+
+#endif
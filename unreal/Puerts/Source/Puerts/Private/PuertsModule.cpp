@@ -271,7 +271,7 @@ IMPLEMENT_MODULE(FPuertsModule, Puerts)
 
 void FPuertsModule::NotifyUObjectCreated(const class UObjectBase* InObject, int32 Index)
 {
-    if (Enabled)
+    if (Enabled && PUERTS_NAMESPACE::FJsEnvGroup::NeedTryBindJs(InObject))
     {
         if (JsEnv.IsValid())
         {
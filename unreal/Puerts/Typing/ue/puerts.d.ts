@@ -44,6 +44,17 @@ declare module "ue" {
         RemoveAt(Index: number): void;
         IsValidIndex(Index: number): boolean;
         Empty(): void;
+        /**
+         * 零拷贝，仅支持数值及只含同种数值字段的结构体。
+         * 只有经过本对象方法(Add/RemoveAt/Empty/CopyFrom等)的内存变化会让旧view失效(长度变为0)；
+         * C++或蓝图修改容器导致内存重新分配时，旧view仍指向已释放的内存，读写会破坏内存。
+         * 调用过可能修改该容器的原生代码后必须先检查IsViewValid，不要跨帧或跨await/yield持有view。
+         */
+        View(): ArrayBufferView;
+        IsViewValid(View: ArrayBufferView): boolean;
+        ToTypedArray(): ArrayBufferView | ArrayBuffer;   // quickjs后端返回ArrayBuffer
+        CopyFrom(Source: ArrayBufferView | ArrayBuffer): number;  // TypedArray元素类型须与容器一致，ArrayBuffer/DataView按字节拷贝
+        ToArray(): T[];
         [Symbol.iterator](): IterableIterator<T>;
     }
     
@@ -59,6 +70,8 @@ declare module "ue" {
         GetMaxIndex(): number;  // TODO - GetMaxIndex的返回值是InvalidIndex，合理吗？（GetMaxIndex的解释应该是：最大合法index+1），当调用Empty，返回值为0
         IsValidIndex(Index: number): boolean;
         Empty(): void;
+        AddRange(Values: T[]): void;
+        ToArray(): T[];
         [Symbol.iterator](): IterableIterator<T>;
     }
     
@@ -73,6 +86,8 @@ declare module "ue" {
         IsValidIndex(Index: number): boolean;
         GetKey(Index: number): TKey;            // TODO - 对于非法index，是否应该返回undefined
         Empty(): void;
+        AddRange(Keys: TKey[], Values: TValue[]): void;
+        ToArray(): [TKey[], TValue[]];
         [Symbol.iterator](): IterableIterator<[TKey, TValue]>;
     }
 